@@ -0,0 +1,670 @@
+#include "../Headers/MathsUtils.h"
+#include "../Headers/AnimationClip.h"
+#include "../Headers/AnimationFile.h"
+#include "../Headers/AnimationUpdate.h"
+#include "../Headers/FrameArena.h"
+#include "../Headers/IKSolver.h"
+#include "../Headers/Skeleton.h"
+#include "../Headers/Skinning.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <atomic>
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#pragma region Helpers
+static std::mt19937 randomEngine(1234);
+
+// Every heap allocation of the process goes through here, so scenarios can report allocations per frame.
+// The deletes stay out of line: once inlined next to the allocation, GCC flags free() as mismatched.
+#if defined(__GNUC__)
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#else
+#define BENCHMARK_NOINLINE
+#endif
+
+static std::atomic<long long> allocationCount(0);
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size > 0 ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+BENCHMARK_NOINLINE void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+BENCHMARK_NOINLINE void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+static Quaternion RandomRotation()
+{
+    std::uniform_real_distribution<float> axisDistribution(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> angleDistribution(-3.14159f, 3.14159f);
+
+    Vector3 axis(axisDistribution(randomEngine), axisDistribution(randomEngine), axisDistribution(randomEngine));
+    Quaternion rotation = Quaternion::FromAxisAngle(axis, angleDistribution(randomEngine));
+
+    // Random sign so half of the pairs are in opposite hemispheres
+    return axisDistribution(randomEngine) < 0.0f ? rotation * -1.0f : rotation;
+}
+
+static float AngleBetween(const Quaternion& a, const Quaternion& b)
+{
+    float dot = std::abs(Dot(Normalize(a), Normalize(b)));
+    return 2.0f * std::acos(Clamp(dot, 0.0f, 1.0f));
+}
+
+// Runs the body a few times and keeps the fastest, returns nanoseconds per item
+static double MeasureNanosecondsPerItem(int itemCount, const std::function<void()>& body)
+{
+    double best = 1e30;
+
+    for (int run = 0; run < 5; run++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        body();
+        auto end = std::chrono::high_resolution_clock::now();
+
+        double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+        if (nanoseconds < best)
+        {
+            best = nanoseconds;
+        }
+    }
+
+    return best / itemCount;
+}
+
+static double ElapsedMicroseconds(std::chrono::high_resolution_clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// Drop the file from the OS page cache so the next open is a real cold start (Linux only)
+static bool EvictFromPageCache(const char* path)
+{
+#if defined(__linux__)
+    int file = open(path, O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    fdatasync(file);
+    bool evicted = posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(file);
+    return evicted;
+#else
+    return false;
+#endif
+}
+#pragma endregion
+
+#pragma region Benchmarks
+void BenchmarkQuaternionBlending()
+{
+    std::cout << "\n=== QUATERNION BLENDING BENCHMARK ===" << std::endl;
+
+    const int Count = 1 << 16;
+    const float T = 0.37f;
+
+    std::vector<Quaternion> from(Count), to(Count), results(Count), reference(Count);
+    for (int i = 0; i < Count; i++)
+    {
+        from[i] = RandomRotation();
+        to[i] = RandomRotation();
+        reference[i] = Slerp(from[i], to[i], T);
+    }
+
+    // Accuracy against exact slerp, in radians of rotation
+    float lerpError = 0.0f;
+    float nlerpError = 0.0f;
+    float approximateError = 0.0f;
+
+    SlerpBatch(from.data(), to.data(), T, results.data(), Count);
+
+    for (int i = 0; i < Count; i++)
+    {
+        lerpError = std::max(lerpError, AngleBetween(Lerp(from[i], to[i], T), reference[i]));
+        nlerpError = std::max(nlerpError, AngleBetween(Nlerp(from[i], to[i], T), reference[i]));
+        approximateError = std::max(approximateError, AngleBetween(results[i], reference[i]));
+    }
+
+    std::cout << "Max error vs Slerp (rad): Lerp " << lerpError << ", Nlerp " << nlerpError << ", SlerpBatch " << approximateError << std::endl;
+
+    // Throughput
+    double lerpTime = MeasureNanosecondsPerItem(Count, [&] { for (int i = 0; i < Count; i++) { results[i] = Lerp(from[i], to[i], T); } });
+    double nlerpTime = MeasureNanosecondsPerItem(Count, [&] { for (int i = 0; i < Count; i++) { results[i] = Nlerp(from[i], to[i], T); } });
+    double slerpTime = MeasureNanosecondsPerItem(Count, [&] { for (int i = 0; i < Count; i++) { results[i] = Slerp(from[i], to[i], T); } });
+    double approximateTime = MeasureNanosecondsPerItem(Count, [&] { for (int i = 0; i < Count; i++) { results[i] = SlerpApproximate(from[i], to[i], T); } });
+    double batchTime = MeasureNanosecondsPerItem(Count, [&] { SlerpBatch(from.data(), to.data(), T, results.data(), Count); });
+
+    std::cout << "ns/quaternion: Lerp " << lerpTime << ", Nlerp " << nlerpTime << ", Slerp " << slerpTime
+        << ", SlerpApproximate " << approximateTime << ", SlerpBatch " << batchTime << std::endl;
+}
+
+void BenchmarkAnimationFileLoading()
+{
+    std::cout << "\n=== ANIMATION FILE LOADING BENCHMARK ===" << std::endl;
+
+    const int BoneCount = 150;
+    const int ClipCount = 40;
+    const int FrameCount = 90;
+    const char* Path = "animation_benchmark.bin";
+
+    Skeleton skeleton;
+    for (int i = 0; i < BoneCount; i++)
+    {
+        skeleton.AddBone("Bone" + std::to_string(i), i - 1, Transform(Vector3(0, 0.1f, 0), Quaternion(), Vector3(1, 1, 1)));
+    }
+
+    std::vector<AnimationClip> clips;
+    for (int c = 0; c < ClipCount; c++)
+    {
+        std::vector<Pose> frames(FrameCount, Pose(BoneCount, Transform()));
+        for (int f = 0; f < FrameCount; f++)
+        {
+            for (int b = 0; b < BoneCount; b++)
+            {
+                frames[f].boneTransforms[b].rotation = Quaternion::FromAxisAngle(Vector3(1, 0, 0), 0.01f * f * (b % 3));
+            }
+        }
+        clips.push_back(CreateAnimationClip("Clip" + std::to_string(c), 30.0f, frames));
+    }
+
+    WriteAnimationFile(Path, skeleton, clips);
+
+    // Open the file and touch every clip once, as a character spawn would
+    Pose pose;
+    auto loadAndSampleAll = [&]()
+    {
+        AnimationFile file;
+        file.Open(Path);
+        for (int c = 0; c < file.GetClipCount(); c++)
+        {
+            SampleAnimationClip(file.GetClip(c), 0.5f, pose);
+        }
+    };
+
+    bool cold = EvictFromPageCache(Path);
+    auto start = std::chrono::high_resolution_clock::now();
+    loadAndSampleAll();
+    double firstLoad = ElapsedMicroseconds(start);
+
+    double warmLoad = 1e30;
+    for (int run = 0; run < 10; run++)
+    {
+        start = std::chrono::high_resolution_clock::now();
+        loadAndSampleAll();
+        warmLoad = std::min(warmLoad, ElapsedMicroseconds(start));
+    }
+
+    std::cout << BoneCount << " bones, " << ClipCount << " clips, " << FrameCount << " frames" << std::endl;
+    std::cout << (cold ? "Cold" : "First (page cache not evicted)") << " open + sample all clips: " << firstLoad << " us" << std::endl;
+    std::cout << "Warm open + sample all clips: " << warmLoad << " us" << std::endl;
+
+    std::remove(Path);
+}
+
+void BenchmarkTwoBoneIK()
+{
+    std::cout << "\n=== TWO-BONE IK BENCHMARK ===" << std::endl;
+
+    const int Count = 1 << 16;
+    const IKChain Chain = { 0.3f, 0.25f };
+    std::uniform_real_distribution<float> distribution(-0.6f, 0.6f);
+
+    // Mostly reachable targets around the shoulder, poles roughly behind the elbow
+    IKBatch batch;
+    batch.Resize(Count);
+    std::vector<Vector3> starts(Count), targets(Count), poles(Count);
+    for (int i = 0; i < Count; i++)
+    {
+        starts[i] = Vector3(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine));
+        targets[i] = starts[i] + Vector3(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine)) * 0.8f;
+        poles[i] = starts[i] + Vector3(0.0f, 0.0f, 1.0f);
+        batch.SetChain(i, starts[i], targets[i], poles[i], Chain);
+    }
+
+    // Accuracy of the batched path against the scalar 3D solve
+    std::vector<IKResult> planarResults(Count);
+    std::vector<IKResult3D> results(Count);
+    SolveTwoBoneIKBatch(batch);
+
+    float positionError = 0.0f;
+    float rotationError = 0.0f;
+    int reachableCount = 0;
+    for (int i = 0; i < Count; i++)
+    {
+        results[i] = SolveTwoBoneIK(starts[i], targets[i], poles[i], Chain);
+        IKResult3D batched = batch.GetResult(i);
+
+        positionError = std::max(positionError, Length(batched.elbowPosition - results[i].elbowPosition));
+        rotationError = std::max(rotationError, AngleBetween(batched.upperRotation, results[i].upperRotation));
+        rotationError = std::max(rotationError, AngleBetween(batched.lowerRotation, results[i].lowerRotation));
+        reachableCount += results[i].isReachable ? 1 : 0;
+    }
+
+    std::cout << Count << " chains, " << reachableCount << " reachable" << std::endl;
+    std::cout << "Batch max error vs scalar 3D: elbow " << positionError << " m, rotation " << rotationError << " rad" << std::endl;
+
+    // Throughput
+    double planarTime = MeasureNanosecondsPerItem(Count, [&] { for (int i = 0; i < Count; i++) { planarResults[i] = SolveTwoBoneIK(starts[i], targets[i], Chain); } });
+    double scalarTime = MeasureNanosecondsPerItem(Count, [&] { for (int i = 0; i < Count; i++) { results[i] = SolveTwoBoneIK(starts[i], targets[i], poles[i], Chain); } });
+    double batchTime = MeasureNanosecondsPerItem(Count, [&] { SolveTwoBoneIKBatch(batch); });
+
+    std::cout << "ns/chain: planar angles " << planarTime << ", 3D scalar " << scalarTime << ", 3D batch " << batchTime << std::endl;
+}
+
+void BenchmarkSkinning()
+{
+    std::cout << "\n=== SKINNING BENCHMARK ===" << std::endl;
+
+    const int VertexCount = 1 << 16;
+    const int BoneCount = 64;
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::uniform_int_distribution<int> boneDistribution(0, BoneCount - 1);
+
+    std::vector<Matrix3x4> palette(BoneCount);
+    std::vector<DualQuaternion> dualPalette(BoneCount);
+    for (int i = 0; i < BoneCount; i++)
+    {
+        Quaternion rotation = RandomRotation();
+        Vector3 translation(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine));
+        palette[i] = ToMatrix3x4(Transform(translation, rotation, Vector3(1.0f, 1.0f, 1.0f)));
+        dualPalette[i] = ToDualQuaternion(rotation, translation);
+    }
+
+    for (int influences : { 4, 8 })
+    {
+        SkinnedMesh mesh;
+        mesh.Resize(VertexCount, influences, BoneCount);
+        for (int v = 0; v < VertexCount; v++)
+        {
+            Vector3 position(distribution(randomEngine), distribution(randomEngine), distribution(randomEngine));
+            mesh.bindVertices.SetVertex(v, position, Normalize(position));
+            for (int i = 0; i < influences; i++)
+            {
+                mesh.SetInfluence(v, i, boneDistribution(randomEngine), distribution(randomEngine) + 1.0f);
+            }
+        }
+        mesh.NormalizeWeights();
+
+        VertexStream skinned;
+        skinned.Resize(VertexCount);
+
+        double linearTime = MeasureNanosecondsPerItem(VertexCount, [&] { SkinVerticesLinear(mesh, palette.data(), 0, VertexCount, skinned); });
+        double dualTime = MeasureNanosecondsPerItem(VertexCount, [&] { SkinVerticesDualQuaternion(mesh, dualPalette.data(), 0, VertexCount, skinned); });
+
+        std::cout << influences << " influences, ns/vertex: linear " << linearTime << ", dual quaternion " << dualTime << std::endl;
+    }
+}
+
+// One point of the crowd matrix; fanOut is the number of clips in each character's blend tree
+struct CrowdScenario
+{
+    int characterCount;
+    int boneCount;
+    int fanOut;
+    bool useIK;
+};
+
+// Accumulated over the measured frames of one pipeline stage
+struct StageTiming
+{
+    const char* name;
+    double nanoseconds = 0.0;
+    long long allocations = 0;
+};
+
+struct CrowdResult
+{
+    CrowdScenario scenario;
+    int frameCount;
+    float sampledClipsPerCharacter;
+    size_t arenaPeakBytes;
+    std::vector<StageTiming> stages;
+};
+
+static void MeasureStage(StageTiming& stage, const std::function<void()>& body)
+{
+    long long allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    auto start = std::chrono::high_resolution_clock::now();
+    body();
+    stage.nanoseconds += std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count();
+    stage.allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+}
+
+// Sized so small scenarios run enough frames to be stable and the largest still finish in seconds
+static int GetCrowdFrameCount(const CrowdScenario& scenario)
+{
+    long long bones = (long long)scenario.characterCount * scenario.boneCount;
+    return (int)std::max<long long>(3, std::min<long long>(1000, 4000000 / bones));
+}
+
+// Runs the update stages one at a time over the whole crowd, in pipeline order, then the fused pipeline
+// (UpdateCharacter) for the end-to-end frame cost and its allocations
+static CrowdResult RunCrowdScenario(const CrowdScenario& scenario)
+{
+    const float DeltaTime = 1.0f / 60.0f;
+    const int ClipFrameCount = 30;
+    int characterCount = scenario.characterCount;
+    int boneCount = scenario.boneCount;
+
+    // Clips are shared by the whole crowd, every bone rotates
+    std::vector<AnimationClip> clips;
+    for (int c = 0; c < scenario.fanOut; c++)
+    {
+        std::vector<Pose> frames(ClipFrameCount, Pose(boneCount, Transform(Vector3(0, 0.1f, 0), Quaternion(), Vector3(1, 1, 1))));
+        for (int f = 0; f < ClipFrameCount; f++)
+        {
+            for (int b = 0; b < boneCount; b++)
+            {
+                frames[f].boneTransforms[b].rotation = Quaternion::FromAxisAngle(Vector3(1, 0, 0), 0.02f * f + 0.01f * b + 0.1f * c);
+            }
+        }
+        clips.push_back(CreateAnimationClip("Clip" + std::to_string(c), 30.0f, frames));
+    }
+
+    BlendTree1D blendTree;
+    for (int c = 0; c < scenario.fanOut; c++)
+    {
+        blendTree.addAnimation((float)c, &clips[c]);
+    }
+
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<Skeleton> skeletons(characterCount);
+    std::vector<StateMachine> stateMachines(characterCount, StateMachine(Idle));
+    std::vector<CharacterInstance> characters(characterCount);
+
+    for (int i = 0; i < characterCount; i++)
+    {
+        for (int b = 0; b < boneCount; b++)
+        {
+            skeletons[i].AddBone("Bone" + std::to_string(b), b == 0 ? -1 : (b - 1) / 3, Transform());
+        }
+        skeletons[i].UpdateWorldPoses();
+
+        stateMachines[i].isGrounded = true;
+        stateMachines[i].speed = 4.0f * unit(randomEngine);
+
+        CharacterInstance& character = characters[i];
+        character.stateMachine = &stateMachines[i];
+        character.blendTree = &blendTree;
+        character.skeleton = &skeletons[i];
+        character.blendParameter = (scenario.fanOut - 1) * unit(randomEngine);
+        character.time = unit(randomEngine);
+        character.useIK = scenario.useIK;
+        character.ikRootBone = boneCount - 1;
+        character.ikChain = { 0.3f, 0.25f };
+        character.ikTarget = Vector3(0.2f, -0.3f, 0.1f);
+    }
+
+    CrowdResult result;
+    result.scenario = scenario;
+    result.frameCount = GetCrowdFrameCount(scenario);
+    result.stages = { { "stateMachine" }, { "weights" }, { "sampling" }, { "blending" }, { "hierarchy" }, { "ik" }, { "frame" } };
+
+    std::vector<BlendWeights1D> weights(characterCount);
+    long long sampledClips = 0;
+
+    // The staged loops keep every character's clip poses from sampling to blending, in a frame arena reset per frame
+    FrameArena arena;
+    std::vector<const Transform*> clipPoses(characterCount * 2);
+
+    // The fused pass replays each frame from the time and state the staged loops started it with
+    std::vector<float> frameStartTimes(characterCount);
+    std::vector<StateMachine> frameStartStates(stateMachines);
+
+    // Frame 0 warms the per-character scratch and is not counted
+    for (int frame = 0; frame <= result.frameCount; frame++)
+    {
+        std::vector<StageTiming>& stages = result.stages;
+        if (frame == 1)
+        {
+            for (StageTiming& stage : stages)
+            {
+                stage.nanoseconds = 0.0;
+                stage.allocations = 0;
+            }
+        }
+
+        arena.Reset();
+        BeginArenaFrame();
+
+        for (int i = 0; i < characterCount; i++)
+        {
+            frameStartTimes[i] = characters[i].time;
+            frameStartStates[i] = stateMachines[i];
+        }
+
+        MeasureStage(stages[0], [&]
+        {
+            for (int i = 0; i < characterCount; i++)
+            {
+                stateMachines[i].update(DeltaTime);
+            }
+        });
+
+        MeasureStage(stages[1], [&]
+        {
+            for (int i = 0; i < characterCount; i++)
+            {
+                characters[i].time += DeltaTime;
+                weights[i] = blendTree.calculateWeights(characters[i].blendParameter);
+            }
+        });
+
+        MeasureStage(stages[2], [&]
+        {
+            for (int i = 0; i < characterCount; i++)
+            {
+                CharacterInstance& character = characters[i];
+                for (int s = 0; s < weights[i].count; s++)
+                {
+                    const AnimationClip& clip = clips[weights[i].samples[s].clipIndex];
+                    Transform* pose = arena.Allocate<Transform>(boneCount);
+                    SampleAnimationClip(clip, std::fmod(character.time, clip.duration), nullptr, 0, pose);
+                    clipPoses[i * 2 + s] = pose;
+                }
+                sampledClips += frame > 0 ? weights[i].count : 0;
+            }
+        });
+
+        MeasureStage(stages[3], [&]
+        {
+            for (int i = 0; i < characterCount; i++)
+            {
+                CharacterInstance& character = characters[i];
+                float blendWeights[2] = { weights[i].samples[0].weight, weights[i].count > 1 ? weights[i].samples[1].weight : 0.0f };
+                character.pose.boneTransforms.resize(boneCount);
+                BlendPoses(&clipPoses[i * 2], blendWeights, weights[i].count, boneCount, nullptr, 0, character.pose.boneTransforms.data());
+            }
+        });
+
+        MeasureStage(stages[4], [&]
+        {
+            for (int i = 0; i < characterCount; i++)
+            {
+                for (int b = 0; b < boneCount; b++)
+                {
+                    skeletons[i].SetLocalTransform(b, characters[i].pose.boneTransforms[b]);
+                }
+                skeletons[i].UpdateWorldPoses();
+            }
+        });
+
+        MeasureStage(stages[5], [&]
+        {
+            for (int i = 0; i < characterCount && scenario.useIK; i++)
+            {
+                CharacterInstance& character = characters[i];
+                Vector3 start = skeletons[i].GetWorldPose(character.ikRootBone).position;
+                character.ikResult = SolveTwoBoneIK(start, character.ikTarget, character.ikChain);
+            }
+        });
+
+        for (int i = 0; i < characterCount; i++)
+        {
+            characters[i].time = frameStartTimes[i];
+            stateMachines[i] = frameStartStates[i];
+        }
+
+        MeasureStage(stages[6], [&]
+        {
+            for (int i = 0; i < characterCount; i++)
+            {
+                UpdateCharacter(characters[i], DeltaTime);
+            }
+        });
+    }
+
+    result.sampledClipsPerCharacter = (float)sampledClips / ((long long)result.frameCount * characterCount);
+    result.arenaPeakBytes = arena.GetPeakBytes();
+    return result;
+}
+
+static void WriteCrowdJson(const char* path, const std::vector<CrowdResult>& results)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        std::cout << "Could not write " << path << std::endl;
+        return;
+    }
+
+    file << "{\n  \"benchmark\": \"crowd\",\n  \"scenarios\": [\n";
+    for (int r = 0; r < results.size(); r++)
+    {
+        const CrowdResult& result = results[r];
+        const CrowdScenario& scenario = result.scenario;
+        double frames = result.frameCount;
+        double bones = (double)scenario.characterCount * scenario.boneCount;
+
+        file << "    {\n";
+        file << "      \"characters\": " << scenario.characterCount << ",\n";
+        file << "      \"bones\": " << scenario.boneCount << ",\n";
+        file << "      \"fanOut\": " << scenario.fanOut << ",\n";
+        file << "      \"ik\": " << (scenario.useIK ? "true" : "false") << ",\n";
+        file << "      \"frames\": " << result.frameCount << ",\n";
+        file << "      \"sampledClipsPerCharacter\": " << result.sampledClipsPerCharacter << ",\n";
+        file << "      \"arenaPeakBytes\": " << result.arenaPeakBytes << ",\n";
+        file << "      \"stages\": {\n";
+        for (int s = 0; s < result.stages.size(); s++)
+        {
+            const StageTiming& stage = result.stages[s];
+            file << "        \"" << stage.name << "\": { "
+                << "\"nsPerFrame\": " << stage.nanoseconds / frames << ", "
+                << "\"nsPerCharacter\": " << stage.nanoseconds / frames / scenario.characterCount << ", "
+                << "\"nsPerBone\": " << stage.nanoseconds / frames / bones << ", "
+                << "\"allocationsPerFrame\": " << stage.allocations / frames << " }"
+                << (s + 1 < result.stages.size() ? "," : "") << "\n";
+        }
+        file << "      }\n";
+        file << "    }" << (r + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+
+    std::cout << "Wrote " << path << std::endl;
+}
+
+// Crowd size, rig size, blend tree fan-out and IK varied one axis at a time around 1000 characters of 60 bones
+void BenchmarkCrowdScenarios(const char* jsonPath)
+{
+    std::cout << "\n=== CROWD SCENARIOS BENCHMARK ===" << std::endl;
+
+    std::vector<CrowdScenario> scenarios;
+    for (int characterCount : { 1, 100, 1000, 10000, 100000 })
+    {
+        scenarios.push_back({ characterCount, 20, 4, true });
+    }
+    for (int boneCount : { 60, 150, 300 })
+    {
+        scenarios.push_back({ 1000, boneCount, 4, true });
+    }
+    for (int fanOut : { 1, 16 })
+    {
+        scenarios.push_back({ 1000, 60, fanOut, true });
+    }
+    scenarios.push_back({ 1000, 60, 4, false });
+
+    std::vector<CrowdResult> results;
+    for (const CrowdScenario& scenario : scenarios)
+    {
+        results.push_back(RunCrowdScenario(scenario));
+        const CrowdResult& result = results.back();
+
+        double characters = scenario.characterCount;
+        double bones = characters * scenario.boneCount;
+        std::printf("%6d characters x %3d bones, fan-out %2d, IK %-3s | ns/character:", scenario.characterCount, scenario.boneCount, scenario.fanOut, scenario.useIK ? "on" : "off");
+        for (const StageTiming& stage : result.stages)
+        {
+            std::printf(" %s %.0f", stage.name, stage.nanoseconds / result.frameCount / characters);
+        }
+
+        const StageTiming& frame = result.stages.back();
+        std::printf(" | frame ns/bone %.1f, allocations/frame %.1f, arena peak %.1f KB\n", frame.nanoseconds / result.frameCount / bones,
+            (double)frame.allocations / result.frameCount, result.arenaPeakBytes / 1024.0);
+    }
+
+    if (jsonPath != nullptr)
+    {
+        WriteCrowdJson(jsonPath, results);
+    }
+}
+#pragma endregion
+
+int main(int argc, char *argv[])
+{
+    std::cout << "=====================================" << std::endl;
+    std::cout << "  ANIMATION SYSTEMS BENCHMARKS" << std::endl;
+    std::cout << "=====================================" << std::endl;
+
+    // --json <path> writes the crowd scenario results, --crowd runs only those
+    const char* jsonPath = nullptr;
+    bool crowdOnly = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--crowd") == 0)
+        {
+            crowdOnly = true;
+        }
+    }
+
+    if (!crowdOnly)
+    {
+        BenchmarkQuaternionBlending();
+        BenchmarkAnimationFileLoading();
+        BenchmarkTwoBoneIK();
+        BenchmarkSkinning();
+    }
+    BenchmarkCrowdScenarios(jsonPath);
+
+    return 0;
+}
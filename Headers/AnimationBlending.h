@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MathsUtils.h"
+#include "Skeleton.h"
 
 #include <vector>
 
@@ -12,5 +13,72 @@ struct Pose
     Pose(int boneCount, const Transform& defaultTransform);
 };
 
+// Structure of Arrays pose: one flat float stream per channel so weighted sums vectorize
+struct PoseSoA
+{
+    std::vector<float> positions; // x, y, z per bone
+    std::vector<float> rotations; // x, y, z, w per bone
+    std::vector<float> scales;    // x, y, z per bone
+
+    PoseSoA();
+    PoseSoA(int boneCount);
+
+    int GetBoneCount() const;
+    void Resize(int boneCount);
+};
+
+// Per-bone layer weights, with the runs of bones whose weight is nonzero so layers skip masked-out ranges
+struct BoneMask
+{
+    std::vector<float> weights;
+    std::vector<BoneSpan> ranges;
+
+    BoneMask();
+    BoneMask(int boneCount, float weight);
+
+    int GetBoneCount() const;
+    void SetBoneWeight(int boneIndex, float weight);
+
+    // Sets every bone of the subtree rooted at rootBone, rootBone included
+    void SetSubtreeWeight(const Skeleton& skeleton, int rootBone, float weight);
+
+private:
+    void RebuildRanges();
+};
+
+// Mask over the subtree rooted at rootBone of skeleton
+BoneMask CreateBoneMask(const Skeleton& skeleton, int rootBone, float weight = 1.0f);
+
+void ToPoseSoA(const Pose& pose, PoseSoA& outPose);
+void ToPose(const PoseSoA& pose, Pose& outPose);
+
 // Blend poses with weights
-Pose BlendPoses(const std::vector<Pose>& poses, std::vector<float> weights);
+// Rotations are accumulated in a common hemisphere and normalized once per bone (nlerp)
+Pose BlendPoses(const std::vector<Pose>& poses, const std::vector<float>& weights);
+
+// Write into a caller-owned pose: no heap allocation once outPose has reached the bone count
+void BlendPoses(const std::vector<Pose>& poses, const std::vector<float>& weights, Pose& outPose);
+void BlendPoses(const Pose* const* poses, const float* weights, int poseCount, Pose& outPose);
+
+// Blend only the listed bones; outPose is sized to the first pose and its other bones are left untouched
+void BlendPoses(const Pose* const* poses, const float* weights, int poseCount, const int* bones, int count, Pose& outPose);
+
+// Caller-managed arrays of boneCount transforms, such as FrameArena allocations; bones null blends every bone.
+// outTransforms must not alias a source.
+void BlendPoses(const Transform* const* poses, const float* weights, int poseCount, int boneCount, const int* bones, int count, Transform* outTransforms);
+void BlendPoses(const std::vector<PoseSoA>& poses, const std::vector<float>& weights, PoseSoA& outPose);
+
+// Override layer: moves each masked bone of pose toward layerPose by weight * its mask weight
+void BlendPoseLayer(Pose& pose, const Pose& layerPose, float weight, const BoneMask& mask);
+
+// Additive delta of pose against referencePose: position and scale differences (Transform::operator-)
+// and the rotation relative to the reference
+void MakeAdditivePose(const Pose& pose, const Pose& referencePose, Pose& outDelta);
+
+// Adds weight * delta on top of pose; the masked overload only visits the mask's ranges
+void AddAdditivePose(Pose& pose, const Pose& delta, float weight);
+void AddAdditivePose(Pose& pose, const Pose& delta, float weight, const BoneMask& mask);
+
+// Additive layer without a precomputed delta: basePose + weight * (additivePose - referencePose); outPose may alias basePose
+void ApplyAdditivePose(const Pose& basePose, const Pose& additivePose, const Pose& referencePose, float weight, Pose& outPose);
+void ApplyAdditivePose(const Pose& basePose, const Pose& additivePose, const Pose& referencePose, float weight, const BoneMask& mask, Pose& outPose);
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "MathsUtils.h"
+#include "AnimationBlending.h"
+#include "RootMotion.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// 48-bit smallest-three quaternion: the largest component is dropped and rebuilt from unit length,
+// the other three are stored on 15 bits each and the dropped index on the remaining 2 bits
+struct CompressedQuaternion
+{
+    uint16_t data[3];
+};
+
+CompressedQuaternion CompressQuaternion(const Quaternion& rotation);
+Quaternion DecompressQuaternion(const CompressedQuaternion& rotation);
+
+enum TrackChannel : uint8_t
+{
+    TrackPosition = 1,
+    TrackRotation = 2,
+    TrackScale = 4
+};
+
+// Per-bone channel lookup: each index points into the constant array of that channel,
+// or into the animated key stream when the channel bit is set in animatedChannels
+struct BoneTrack
+{
+    uint16_t positionIndex;
+    uint16_t rotationIndex;
+    uint16_t scaleIndex;
+    uint8_t animatedChannels;
+};
+
+// Non-owning view over clip data, backed either by an AnimationClip or by a memory-mapped animation file
+struct AnimationClipView
+{
+    float duration = 0.0f;
+    float sampleRate = 0.0f;
+    int frameCount = 0;
+    int boneCount = 0;
+
+    int animatedPositionCount = 0;
+    int animatedRotationCount = 0;
+    int animatedScaleCount = 0;
+
+    const BoneTrack* boneTracks = nullptr;
+    const Vector3* constantPositions = nullptr;
+    const CompressedQuaternion* constantRotations = nullptr;
+    const Vector3* constantScales = nullptr;
+    const Vector3* positionKeys = nullptr;
+    const CompressedQuaternion* rotationKeys = nullptr;
+    const Vector3* scaleKeys = nullptr;
+
+    // frameCount keys, or null for clips without root motion
+    const RootMotion* rootMotionKeys = nullptr;
+};
+
+struct AnimationClip
+{
+    std::string name;
+    float duration;
+
+    float sampleRate = 30.0f;
+    int frameCount = 0;
+    std::vector<BoneTrack> boneTracks = {};
+
+    // Constant tracks are collapsed to a single value
+    std::vector<Vector3> constantPositions = {};
+    std::vector<CompressedQuaternion> constantRotations = {};
+    std::vector<Vector3> constantScales = {};
+
+    // Animated keys are stored frame-major: every animated channel of a frame is contiguous,
+    // so sampling a pose reads two consecutive blocks of memory
+    int animatedPositionCount = 0;
+    int animatedRotationCount = 0;
+    int animatedScaleCount = 0;
+    std::vector<Vector3> positionKeys = {};
+    std::vector<CompressedQuaternion> rotationKeys = {};
+    std::vector<Vector3> scaleKeys = {};
+
+    // Root motion baked out of the root bone: one key per frame, the motion since frame 0.
+    // Empty when the clip was built without a root motion bone.
+    std::vector<RootMotion> rootMotionKeys = {};
+
+    int GetBoneCount() const;
+    size_t GetMemoryUsage() const;
+    AnimationClipView GetView() const;
+};
+
+// Build a clip from uniformly sampled poses, collapsing channels that stay within tolerance of their first key
+// (position and scale per component, rotation by angle in radians).
+// With a rootMotionBone, that bone's horizontal movement and heading are moved into the root motion track
+// and its pose stays in place (Y up).
+AnimationClip CreateAnimationClip(const std::string& name, float sampleRate, const std::vector<Pose>& frames, float tolerance = 0.0001f, int rootMotionBone = -1, float angularTolerance = 0.0001f);
+
+// Decode the whole pose at time (clamped to the clip duration) into a caller-owned pose
+void SampleAnimationClip(const AnimationClip& clip, float time, Pose& outPose);
+void SampleAnimationClip(const AnimationClipView& clip, float time, Pose& outPose);
+
+// Decode only the listed bones; outPose is sized to the clip and its other bones are left untouched
+void SampleAnimationClip(const AnimationClip& clip, float time, const int* bones, int count, Pose& outPose);
+void SampleAnimationClip(const AnimationClipView& clip, float time, const int* bones, int count, Pose& outPose);
+
+// Into caller-managed storage of clip.boneCount transforms, such as a FrameArena allocation; bones null decodes every bone
+void SampleAnimationClip(const AnimationClip& clip, float time, const int* bones, int count, Transform* outTransforms);
+void SampleAnimationClip(const AnimationClipView& clip, float time, const int* bones, int count, Transform* outTransforms);
+
+// Root displacement between two unwrapped times of a looping clip, composed across every loop boundary
+// in between; a reversed window gives the inverse. Reads only the root motion track, never the pose.
+RootMotion GetRootMotion(const AnimationClip& clip, float startTime, float endTime);
+RootMotion GetRootMotion(const AnimationClipView& clip, float startTime, float endTime);
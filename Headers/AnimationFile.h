@@ -0,0 +1,107 @@
+#pragma once
+
+#include "MathsUtils.h"
+#include "AnimationClip.h"
+#include "Skeleton.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Flat little-endian animation file: one skeleton and its compressed clips.
+// Every section is 16-byte aligned and referenced by offset from the start of the file,
+// so a mapped file is used in place without parsing.
+//
+// [AnimationFileHeader]
+// [Skeleton: parent indices | name offsets | bind-pose local Transforms]
+// [AnimationFileClip table]
+// [Clip data: bone tracks | constant channels | animated keys | root motion keys, per clip]
+// [String table: null-terminated names]
+
+static const uint32_t AnimationFileMagic = 0x4D494E41; // "ANIM"
+static const uint32_t AnimationFileVersion = 2;
+
+struct AnimationFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fileSize;
+    uint32_t boneCount;
+    uint32_t clipCount;
+    uint32_t parentIndicesOffset;
+    uint32_t boneNamesOffset;
+    uint32_t bindPoseOffset;
+    uint32_t clipTableOffset;
+    uint32_t stringTableOffset;
+    uint32_t stringTableSize;
+};
+
+struct AnimationFileClip
+{
+    uint32_t nameOffset;
+    float duration;
+    float sampleRate;
+    uint32_t frameCount;
+    uint32_t animatedPositionCount;
+    uint32_t animatedRotationCount;
+    uint32_t animatedScaleCount;
+    uint32_t constantPositionCount;
+    uint32_t constantRotationCount;
+    uint32_t constantScaleCount;
+    uint32_t boneTracksOffset;
+    uint32_t constantPositionsOffset;
+    uint32_t constantRotationsOffset;
+    uint32_t constantScalesOffset;
+    uint32_t positionKeysOffset;
+    uint32_t rotationKeysOffset;
+    uint32_t scaleKeysOffset;
+    uint32_t rootMotionKeyCount; // 0 or frameCount
+    uint32_t rootMotionKeysOffset;
+};
+
+// Non-owning view over the skeleton stored in an animation file
+struct SkeletonView
+{
+    int boneCount = 0;
+    const int32_t* parentIndices = nullptr;
+    const uint32_t* nameOffsets = nullptr;
+    const Transform* bindPose = nullptr;
+    const char* stringTable = nullptr;
+
+    const char* GetBoneName(int boneIndex) const;
+};
+
+// Offline converter: write a skeleton and its clips to a flat animation file
+bool WriteAnimationFile(const std::string& path, const Skeleton& skeleton, const std::vector<AnimationClip>& clips);
+
+// Copy a skeleton view into a mutable Skeleton
+void BuildSkeleton(const SkeletonView& view, Skeleton& outSkeleton);
+
+// Read-only memory-mapped animation file. Views stay valid until Close.
+class AnimationFile
+{
+public:
+    AnimationFile();
+    ~AnimationFile();
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const;
+
+    SkeletonView GetSkeleton() const;
+    int GetClipCount() const;
+    const char* GetClipName(int clipIndex) const;
+    int FindClip(const std::string& name) const;
+    AnimationClipView GetClip(int clipIndex) const;
+
+private:
+    AnimationFile(const AnimationFile&) = delete;
+    AnimationFile& operator=(const AnimationFile&) = delete;
+
+    bool Validate() const;
+
+    const unsigned char* data;
+    size_t size;
+    void* fileHandle;
+    void* mappingHandle;
+};
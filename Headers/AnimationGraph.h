@@ -0,0 +1,127 @@
+#pragma once
+
+#include "AnimationBlending.h"
+#include "AnimationClip.h"
+#include "BlendSpace2D.h"
+#include "BlendTree1D.h"
+#include "StateMachine.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+enum AnimationNodeType : uint8_t
+{
+    ClipNode,
+    Blend1DNode,
+    Blend2DNode,
+    StateMachineNode,
+    AdditiveNode,
+    LayerNode
+};
+
+// Child of a 1D blend node, placed at a threshold on the node's parameter
+struct BlendChild1D
+{
+    float threshold;
+    int node;
+};
+
+// Graph nodes live in one arena; children are referenced by index and stored contiguously per node
+struct AnimationNode
+{
+    AnimationNodeType type;
+    int parameter;
+    int parameterY;
+    int firstChild;
+    int childCount;
+
+    const AnimationClip* clip;
+    const BlendSpace2D* blendSpace;
+    const Pose* referencePose;
+    const BoneMask* mask;
+};
+
+// Per-character evaluation state: parameter values, bound state machines and reusable scratch
+struct AnimationGraphContext
+{
+    std::vector<float> parameters;
+    std::vector<const StateMachineInstance*> stateMachines;
+    float time = 0.0f;
+
+    // Length of the window ending at time that root motion is taken over
+    float deltaTime = 0.0f;
+
+    // Subtrees whose effective weight falls below this are neither sampled nor blended
+    float weightThreshold = 0.001f;
+
+    // Optional bone list: clips sample and blends mix only these bones, the others of the output pose are stale.
+    // Layers still run over their masks.
+    const int* bones = nullptr;
+    int boneCount = 0;
+
+    // Root motion of the evaluated clips, blended with the pose weights; additive and override layers add none
+    RootMotion rootMotion;
+
+    // Statistics of the last evaluation
+    int sampledClipCount = 0;
+    int blendedPoseCount = 0;
+
+    // Scratch
+    std::vector<float> nodeWeights;
+    std::vector<float> childWeights;
+    std::deque<Pose> posePool;
+    std::vector<Pose*> freePoses;
+    std::vector<Pose*> blendPoses;
+    std::vector<float> blendWeights;
+};
+
+// Nested blend graph: clips, 1D and 2D blends, state machines, masked and additive layers composed freely.
+// Nodes are added bottom-up, so every child index is lower than its parent's.
+class AnimationGraph
+{
+public:
+    int AddParameter(const std::string& name);
+    int FindParameter(const std::string& name) const;
+    int GetParameterCount() const;
+
+    // Each Add returns the node index, or -1 if a child or parameter is invalid
+    int AddClip(const AnimationClip* clip);
+    int AddBlend1D(int parameter, std::initializer_list<BlendChild1D> children);
+
+    // One child per clip of blendSpace, in clip order; the space only provides the weights
+    int AddBlend2D(int parameterX, int parameterY, const BlendSpace2D* blendSpace, std::initializer_list<int> children);
+
+    // One child per state of the machine bound to stateMachineSlot in the context, in state order
+    int AddStateMachine(int stateMachineSlot, std::initializer_list<int> children);
+
+    // Adds additiveNode's difference from referencePose on top of baseNode, scaled by the weight parameter
+    // and, when given, by the per-bone mask
+    int AddAdditive(int baseNode, int additiveNode, const Pose* referencePose, int weightParameter, const BoneMask* mask = nullptr);
+
+    // Overrides the masked bones of baseNode with layerNode (e.g. an upper-body aim), scaled by the weight parameter
+    int AddLayer(int baseNode, int layerNode, const BoneMask* mask, int weightParameter);
+
+    void SetRoot(int node);
+    int GetNodeCount() const;
+
+    // Sizes the context's parameters and state machine slots for this graph
+    void InitializeContext(AnimationGraphContext& context) const;
+
+    // Propagates weights top-down, then samples and blends only subtrees above the weight threshold
+    bool Evaluate(AnimationGraphContext& context, Pose& outPose) const;
+
+private:
+    bool IsValidChild(int node) const;
+    int AddNode(AnimationNodeType type, int parameter, int parameterY, std::initializer_list<int> children);
+
+    void PropagateWeights(AnimationGraphContext& context) const;
+    bool EvaluateNode(AnimationGraphContext& context, int node, float rootMotionWeight, Pose& outPose) const;
+
+    std::vector<std::string> parameterNames;
+    std::vector<AnimationNode> nodes;
+    std::vector<int> childNodes;
+    std::vector<float> childThresholds;
+    int stateMachineSlotCount = 0;
+    int root = -1;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+
+struct CharacterInstance;
+
+// How much of the update pipeline a character pays for
+struct AnimationLODLevel
+{
+    // Full pose evaluation (state machine, blend weights, sampling, blending) every updateInterval frames;
+    // the frames in between interpolate between the last two evaluated poses
+    int updateInterval = 1;
+
+    // Bones deeper than this in the hierarchy are neither sampled, blended nor written to the skeleton (-1 keeps all);
+    // they keep their last local pose and still follow their parents
+    int maxBoneDepth = -1;
+
+    bool enableIK = true;
+
+    // Distance mode: a character uses the first level whose maxDistance covers its lodDistance
+    float maxDistance = 1e30f;
+
+    // Budget mode: starting estimate of one character-frame at this level, refined by RecordCosts
+    float costMicroseconds = 0.0f;
+};
+
+// Chooses a level per character, from its distance alone or to fit a per-frame time budget.
+// Levels are added from most to least detailed.
+class AnimationLODPolicy
+{
+public:
+    int AddLevel(const AnimationLODLevel& level);
+    int GetLevelCount() const;
+    const AnimationLODLevel& GetLevel(int level) const;
+
+    int SelectLevel(float distance) const;
+
+    void AssignByDistance(CharacterInstance* characters, int count);
+
+    // Closest characters first: each keeps its distance level while the rest of the crowd still fits
+    // budgetMicroseconds at the coarsest level, and is coarsened otherwise
+    void AssignByBudget(CharacterInstance* characters, int count, float budgetMicroseconds);
+
+    // Folds the last frame's measured update times into the per-level cost estimates
+    void RecordCosts(const CharacterInstance* characters, int count);
+    float GetEstimatedCost(int level) const;
+
+private:
+    void SetLevel(CharacterInstance& character, int level, int index) const;
+
+    std::vector<AnimationLODLevel> levels;
+    std::vector<float> estimatedCosts;
+
+    // Scratch
+    std::vector<int> order;
+    std::vector<float> costSums;
+    std::vector<int> costCounts;
+};
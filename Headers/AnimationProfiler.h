@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Build with ANIMATION_PROFILING defined to instrument the update pipeline.
+// Without it the macros compile to nothing and the snapshot API reports no data.
+#if defined(ANIMATION_PROFILING)
+#define ANIMATION_PROFILE_CONCAT_INNER(a, b) a##b
+#define ANIMATION_PROFILE_CONCAT(a, b) ANIMATION_PROFILE_CONCAT_INNER(a, b)
+#define ANIMATION_PROFILE_SCOPE(stage) ProfileScope ANIMATION_PROFILE_CONCAT(profileScope, __LINE__)(stage)
+#define ANIMATION_PROFILE_COUNT(counter, amount) AddProfileCount(counter, amount)
+#else
+#define ANIMATION_PROFILE_SCOPE(stage)
+#define ANIMATION_PROFILE_COUNT(counter, amount)
+#endif
+
+// ProfileUpdate covers a whole character update, the other stages nest inside it
+enum ProfileStage : uint8_t
+{
+    ProfileUpdate,
+    ProfileStateMachine,
+    ProfileBlendWeights,
+    ProfileSampling,
+    ProfileBlending,
+    ProfileHierarchy,
+    ProfileIK,
+    ProfileStageCount
+};
+
+enum ProfileCounter : uint8_t
+{
+    CounterCharacters,
+    CounterClipsSampled,
+    CounterPosesBlended,
+    CounterBonesProcessed,
+    // Analytic two-bone solves, and iterations of the iterative FABRIK and CCD solvers
+    CounterIKSolves,
+    CounterIKIterations,
+    CounterIKUnreachable,
+    ProfileCounterCount
+};
+
+static const int ProfileHistogramBuckets = 32;
+
+// Threads beyond this many record nothing
+static const int MaxProfileThreads = 64;
+
+// Timings cover the sampled scopes only (see SetProfileSampleInterval): the mean per call is unbiased,
+// totals per frame are about sampleInterval times larger
+struct ProfileStageStats
+{
+    uint64_t calls = 0;
+    double totalNanoseconds = 0.0;
+    double maxNanoseconds = 0.0;
+
+    // Bucket i counts the scopes that took [2^i, 2^(i+1)) profiler clock ticks, see ProfileSnapshot::GetBucketNanoseconds
+    uint64_t histogram[ProfileHistogramBuckets] = {};
+};
+
+struct ProfileThreadSnapshot
+{
+    // Order in which the thread first recorded something
+    int thread = 0;
+    ProfileStageStats stages[ProfileStageCount];
+    uint64_t counters[ProfileCounterCount] = {};
+};
+
+struct ProfileSnapshot
+{
+    double nanosecondsPerTick = 1.0;
+    int sampleInterval = 1;
+    std::vector<ProfileThreadSnapshot> threads;
+
+    // Merged over every thread
+    ProfileStageStats GetStage(ProfileStage stage) const;
+    uint64_t GetCounter(ProfileCounter counter) const;
+
+    // Lower bound of a histogram bucket
+    double GetBucketNanoseconds(int bucket) const;
+};
+
+const char* GetProfileStageName(ProfileStage stage);
+const char* GetProfileCounterName(ProfileCounter counter);
+
+// Each thread times one in every interval of its outermost scopes, together with the scopes nested in it,
+// and skips the clock for the others; counters always count. 1 times every scope.
+void SetProfileSampleInterval(int interval);
+
+// Reads every thread's data while they keep recording, without locks: a value is never torn,
+// but a scope that is still open is not in the snapshot yet
+void TakeProfileSnapshot(ProfileSnapshot& outSnapshot);
+
+// Zeroes every thread's data; call between frames, when no thread records
+void ResetProfile();
+
+// Per-thread and merged stages (histograms included) and counters as JSON
+void ExportProfileJson(const ProfileSnapshot& snapshot, std::ostream& out);
+
+// Recording, normally reached through the macros, inline so an unsampled scope or a counter costs a few instructions.
+// One slot per recording thread, on its own cache lines. Only the owning thread writes a slot,
+// so plain relaxed load/store pairs are enough and snapshots read it concurrently.
+struct alignas(64) ProfileThreadData
+{
+    std::atomic<uint64_t> calls[ProfileStageCount];
+    std::atomic<uint64_t> ticks[ProfileStageCount];
+    std::atomic<uint64_t> maxTicks[ProfileStageCount];
+    std::atomic<uint64_t> histogram[ProfileStageCount][ProfileHistogramBuckets];
+    std::atomic<uint64_t> counters[ProfileCounterCount];
+};
+
+struct ProfileThreadState
+{
+    ProfileThreadData* data;
+    int depth;
+    unsigned int outermostScopes;
+    bool sampling;
+    bool registered;
+};
+
+// Constant-initialized, so reaching it costs no initialization check
+inline thread_local ProfileThreadState profileThreadState = { nullptr, 0, 0, false, false };
+
+uint64_t ReadProfileClock();
+
+// Claims the thread's slot on first use, null once every slot is taken
+ProfileThreadData* RegisterProfileThread();
+
+// Decides whether an outermost scope is sampled, returns its start tick or 0
+uint64_t BeginOutermostProfileScope();
+void RecordProfileScope(ProfileStage stage, uint64_t start);
+
+// Start tick, or 0 when the scope is not sampled
+inline uint64_t BeginProfileScope()
+{
+    ProfileThreadState& state = profileThreadState;
+    if (state.depth++ == 0)
+    {
+        return BeginOutermostProfileScope();
+    }
+
+    // Never 0, which marks an unsampled scope
+    return state.sampling ? ReadProfileClock() | 1 : 0;
+}
+
+inline void EndProfileScope(ProfileStage stage, uint64_t start)
+{
+    profileThreadState.depth--;
+    if (start != 0)
+    {
+        RecordProfileScope(stage, start);
+    }
+}
+
+inline void AddProfileCount(ProfileCounter counter, uint64_t amount)
+{
+    ProfileThreadData* data = profileThreadState.registered ? profileThreadState.data : RegisterProfileThread();
+    if (data != nullptr)
+    {
+        std::atomic<uint64_t>& value = data->counters[counter];
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+}
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(ProfileStage stage) : stage(stage), start(BeginProfileScope()) {}
+    ~ProfileScope() { EndProfileScope(stage, start); }
+
+private:
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    ProfileStage stage;
+    uint64_t start;
+};
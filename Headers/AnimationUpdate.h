@@ -0,0 +1,106 @@
+#pragma once
+
+#include "AnimationBlending.h"
+#include "AnimationGraph.h"
+#include "AnimationLOD.h"
+#include "BlendSpace2D.h"
+#include "BlendTree1D.h"
+#include "IKSolver.h"
+#include "JobSystem.h"
+#include "Skeleton.h"
+#include "StateMachine.h"
+
+#include <vector>
+
+// One animated character: the pieces it is built from plus per-character scratch reused across frames
+struct CharacterInstance
+{
+    StateMachine* stateMachine = nullptr;
+    BlendTree1D* blendTree = nullptr;
+    Skeleton* skeleton = nullptr;
+
+    // Optional blend tree per state machine state; when set it replaces blendTree and cross-fades on transitions
+    std::vector<BlendTree1D*> stateBlendTrees;
+
+    // Optional animation graph; state machine slot 0 is bound to stateMachine, parameters are set by the caller.
+    // Takes precedence over the blend space and blend trees.
+    const AnimationGraph* graph = nullptr;
+    AnimationGraphContext graphContext;
+
+    // Optional 2D blend space sampled at (blendParameter, blendParameterY); takes precedence over the blend trees
+    const BlendSpace2D* blendSpace = nullptr;
+
+    float blendParameter = 0.0f;
+    float blendParameterY = 0.0f;
+    float time = 0.0f;
+    float previousTime = 0.0f;
+
+    // Root motion of the last update, blended like the pose, and the character's integrated world root.
+    // With a throttled LOD it arrives on full update frames and covers the frames skipped since.
+    RootMotion rootMotion;
+    RootMotionAccumulator rootMotionAccumulator;
+
+    // Optional two-bone IK, started from the world position of ikRootBone
+    bool useIK = false;
+    int ikRootBone = -1;
+    IKChain ikChain = IKChain();
+    Vector3 ikTarget;
+    IKResult ikResult = IKResult();
+
+    // Level of detail, usually assigned by an AnimationLODPolicy from lodDistance
+    AnimationLODLevel lod;
+    int lodLevel = 0;
+    float lodDistance = 0.0f;
+
+    // Wall time of the last update, measured for the LOD budget
+    float lastUpdateMicroseconds = 0.0f;
+
+    // Throttled updates: frames since the last full evaluation, time accumulated since then,
+    // and the last two evaluated poses interpolated in between
+    int framesSinceUpdate = 0;
+    float pendingDeltaTime = 0.0f;
+    Pose lodSourcePose;
+    Pose lodTargetPose;
+
+    // Headless mode: the ancestor closure of the bones gameplay reads (see SetRequiredBones).
+    // When set, only these bones are sampled, blended, written and propagated; the others go stale.
+    std::vector<int> requiredBones;
+
+    // Parent-first bones actually evaluated: the required bones, or every bone, cut to lod.maxBoneDepth.
+    // Rebuilt when the depth or the required set changes.
+    std::vector<int> lodBones;
+    int lodBonesDepth = -1;
+    bool lodBonesDirty = true;
+
+    // Clips sampled by the last blend tree or blend space evaluation
+    int sampledClipCount = 0;
+
+    // Evaluated local pose. Clip poses and blend lists only live during the update, in the thread's FrameArena.
+    Pose pose;
+
+    // Scratch
+    std::vector<int> serialBones;
+    std::vector<BoneSpan> boneSpans;
+};
+
+struct AnimationUpdateSettings
+{
+    int characterGrainSize = 1;
+
+    // Rigs with at least this many bones also split hierarchy propagation per subtree (0 disables)
+    int subtreeSplitBoneCount = 0;
+    int maxSubtreeSpanBones = 64;
+};
+
+// Restricts the character to bones and their ancestors, so its cost scales with the bones gameplay needs
+// rather than the rig size (count 0 restores the full skeleton). Needs character.skeleton.
+void SetRequiredBones(CharacterInstance& character, const int* bones, int count);
+
+// Runs state machine, blend weights, clip sampling and blending, hierarchy propagation and IK for one character,
+// throttled by its LOD level. Transient buffers come from the thread's FrameArena and are released before it returns.
+void UpdateCharacter(CharacterInstance& character, float deltaTime);
+
+// Same stages for every character, split per character across the job system.
+// Every character only touches its own data, so results do not depend on the thread count.
+// Starts a new frame for the thread arenas (BeginArenaFrame).
+void UpdateCharacters(JobSystem& jobs, CharacterInstance* characters, int count, float deltaTime, const AnimationUpdateSettings& settings);
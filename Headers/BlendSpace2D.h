@@ -0,0 +1,67 @@
+#pragma once
+
+#include "BlendTree1D.h"
+
+#include <vector>
+
+// Sparse 2D blend result: at most the 3 clips of one triangle, weights sum to 1
+struct BlendWeights2D
+{
+    BlendSample samples[3];
+    int count;
+};
+
+// Freeform Cartesian blend space (e.g. speed x direction).
+// Clip positions are Delaunay-triangulated when added, and a uniform grid over the triangles
+// makes finding the triangle under a parameter constant-time on average.
+class BlendSpace2D
+{
+public:
+    void addAnimation(float x, float y, AnimationClip* clip);
+
+    // Barycentric weights of the containing triangle; outside the hull the parameter is projected onto the nearest hull edge
+    BlendWeights2D calculateWeights(float x, float y) const;
+    void printWeights(float x, float y) const;
+
+    int getClipCount() const;
+    AnimationClip* getClip(int index) const;
+    int getTriangleCount() const;
+
+private:
+    struct BlendPoint
+    {
+        float x, y;
+    };
+
+    struct BlendTriangle
+    {
+        int vertices[3];
+
+        // Barycentric setup: origin at vertices[0] and inverse of the edge matrix
+        float originX, originY;
+        float inverse[4];
+    };
+
+    struct BlendEdge
+    {
+        int a, b;
+    };
+
+    void triangulate();
+    void buildGrid();
+    bool findTriangle(float x, float y, BlendWeights2D& outWeights) const;
+    void projectOnHull(float x, float y, BlendWeights2D& outWeights) const;
+
+    std::vector<BlendPoint> points;
+    std::vector<AnimationClip*> clips;
+
+    std::vector<BlendTriangle> triangles;
+    std::vector<BlendEdge> hullEdges;
+
+    // Triangles overlapping each grid cell, flattened
+    float gridMinX = 0.0f, gridMinY = 0.0f;
+    float cellSizeX = 1.0f, cellSizeY = 1.0f;
+    int gridSize = 0;
+    std::vector<int> cellTriangleStart;
+    std::vector<int> cellTriangles;
+};
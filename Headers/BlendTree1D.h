@@ -1,20 +1,40 @@
 #pragma once
 
+#include "AnimationClip.h"
+
 #include <string>
 #include <vector>
 
-struct AnimationClip
+// One clip of a blend with a nonzero weight
+struct BlendSample
+{
+    int clipIndex;
+    float weight;
+};
+
+// Sparse 1D blend result: at most the 2 clips around the parameter, weights sum to 1
+struct BlendWeights1D
 {
-    std::string name;
-    float duration;
+    BlendSample samples[2];
+    int count;
 };
 
+// Weights of the two thresholds around parameter, for thresholds sorted in ascending order
+BlendWeights1D CalculateBlendWeights1D(const float* thresholds, int thresholdCount, float parameter);
+
 class BlendTree1D
 {
 public:
+    // Keeps thresholds sorted, so clip indices follow threshold order
     void addAnimation(float threshold, AnimationClip* clip);
-    std::vector<float> calculateWeights(float parameter);
-    void printWeights(float parameter);
+    BlendWeights1D calculateWeights(float parameter) const;
+
+    // Evaluates many parameters at once (e.g. one per crowd member)
+    void calculateWeights(const float* parameters, BlendWeights1D* outWeights, int count) const;
+
+    void printWeights(float parameter) const;
+    int getClipCount() const;
+    AnimationClip* getClip(int index) const;
 
 private:
     std::vector<float> thresholds;
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+struct FrameArenaMarker
+{
+    int block = 0;
+    size_t offset = 0;
+};
+
+// Linear allocator for buffers that live at most one frame: an allocation bumps an offset, a marker
+// rewinds everything allocated after it, and Reset releases the whole frame. Memory is only returned
+// to the system when the arena is destroyed, so a warm arena never touches the heap.
+class FrameArena
+{
+public:
+    explicit FrameArena(size_t initialCapacity = 0);
+
+    void* Allocate(size_t size, size_t alignment);
+
+    // Uninitialized storage for count values, 16-byte aligned at least; released without running destructors
+    template <typename T>
+    T* Allocate(int count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        return static_cast<T*>(Allocate(sizeof(T) * (count > 0 ? count : 0), alignof(T) > 16 ? alignof(T) : 16));
+    }
+
+    FrameArenaMarker GetMarker() const;
+    void Rewind(const FrameArenaMarker& marker);
+
+    // Releases everything; a frame that overflowed into extra blocks leaves a single block of their total size
+    void Reset();
+
+    size_t GetUsedBytes() const;
+    size_t GetCapacity() const;
+
+    // Highest usage since construction, padding included: the capacity to reserve so a frame never grows the arena
+    size_t GetPeakBytes() const;
+
+    // Heap blocks allocated since construction
+    int GetBlockAllocationCount() const;
+
+private:
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    struct Block
+    {
+        std::unique_ptr<unsigned char[]> memory;
+        size_t size;
+
+        // Bytes of the blocks before this one, so usage is one addition
+        size_t start;
+    };
+
+    void AddBlock(size_t size);
+
+    std::vector<Block> blocks;
+    int currentBlock = 0;
+    size_t offset = 0;
+
+    // Written by the owning thread only, read by GetFrameArenaStatistics from any thread
+    std::atomic<size_t> capacity;
+    std::atomic<size_t> peakBytes;
+    std::atomic<int> blockAllocationCount;
+};
+
+// Releases what was allocated from arena during its lifetime
+class FrameArenaScope
+{
+public:
+    explicit FrameArenaScope(FrameArena& arena) : arena(arena), marker(arena.GetMarker()) {}
+    ~FrameArenaScope() { arena.Rewind(marker); }
+
+private:
+    FrameArenaScope(const FrameArenaScope&) = delete;
+    FrameArenaScope& operator=(const FrameArenaScope&) = delete;
+
+    FrameArena& arena;
+    FrameArenaMarker marker;
+};
+
+// The calling thread's arena, created on first use. The first use in a frame resets it (see BeginArenaFrame).
+FrameArena& GetThreadFrameArena();
+
+// Starts a new frame: every thread arena resets on its next use, from its own thread.
+// Call between frames, while no thread holds arena memory.
+void BeginArenaFrame();
+
+// Over every live thread arena
+struct FrameArenaStatistics
+{
+    int arenaCount = 0;
+    size_t capacity = 0;
+    size_t peakBytes = 0;
+
+    // Largest single-thread peak, the size to reserve per arena
+    size_t maxArenaPeakBytes = 0;
+    int blockAllocationCount = 0;
+};
+
+FrameArenaStatistics GetFrameArenaStatistics();
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "MathsUtils.h"
+#include "Skeleton.h"
 
 #include <cmath>
+#include <cstdint>
+#include <vector>
 
 struct IKChain
 {
@@ -17,4 +20,84 @@ struct IKResult
 	bool isReachable;
 };
 
+// Bones point along +X in their rest frame and bend in their local XY plane.
+// Unreachable targets still get the closest pose (arm straightened or folded toward the target).
+struct IKResult3D
+{
+	Quaternion upperRotation;
+	Quaternion lowerRotation;
+	Vector3 elbowPosition;
+	Vector3 endPosition;
+	bool isReachable;
+};
+
 IKResult SolveTwoBoneIK(const Vector3& start, const Vector3& target, const IKChain& chain);
+
+// Full 3D solve: the elbow bends toward the pole position, rotations are world space
+IKResult3D SolveTwoBoneIK(const Vector3& start, const Vector3& target, const Vector3& pole, const IKChain& chain);
+
+// Structure of Arrays batch of two-bone problems for crowds
+struct IKBatch
+{
+	std::vector<float> startX, startY, startZ;
+	std::vector<float> targetX, targetY, targetZ;
+	std::vector<float> poleX, poleY, poleZ;
+	std::vector<float> upperLength, lowerLength;
+
+	// Results
+	std::vector<float> elbowX, elbowY, elbowZ;
+	std::vector<float> endX, endY, endZ;
+	std::vector<float> upperRotationX, upperRotationY, upperRotationZ, upperRotationW;
+	std::vector<float> lowerRotationX, lowerRotationY, lowerRotationZ, lowerRotationW;
+	std::vector<uint8_t> reachable;
+
+	int GetCount() const;
+	void Resize(int count);
+	void SetChain(int index, const Vector3& start, const Vector3& target, const Vector3& pole, const IKChain& chain);
+	IKResult3D GetResult(int index) const;
+};
+
+// Same solve as the 3D SolveTwoBoneIK, 4 chains per SSE iteration, trig-free with approximate reciprocal square roots
+void SolveTwoBoneIKBatch(IKBatch& batch);
+
+// Multi-bone chain read from a skeleton, from startBone down to the end effector endBone
+struct IKBoneChain
+{
+	std::vector<int> bones;
+
+	// Local rotations of the last solve, used as the next frame's starting pose when warm starting
+	std::vector<Quaternion> solvedRotations;
+	bool hasSolution = false;
+
+	// Scratch
+	std::vector<Transform> localPoses;
+	std::vector<Vector3> positions;
+	std::vector<Quaternion> rotations;
+	std::vector<Vector3> solvedPositions;
+	std::vector<float> lengths;
+};
+
+struct IKIterativeSettings
+{
+	int maxIterations = 10;
+
+	// Distance from the end effector to the target below which iterating stops
+	float tolerance = 0.001f;
+
+	bool warmStart = true;
+};
+
+struct IKIterativeResult
+{
+	int iterations;
+	float error;
+	bool isReachable;
+};
+
+// Fails if endBone is not startBone or one of its descendants
+bool BuildIKBoneChain(const Skeleton& skeleton, int startBone, int endBone, IKBoneChain& outChain);
+
+// Both solvers rotate every chain bone but the end effector and write the result back with SetLocalTransform.
+// World poses are not updated; call UpdateWorldPoses afterwards.
+IKIterativeResult SolveFABRIK(Skeleton& skeleton, IKBoneChain& chain, const Vector3& target, const IKIterativeSettings& settings);
+IKIterativeResult SolveCCD(Skeleton& skeleton, IKBoneChain& chain, const Vector3& target, const IKIterativeSettings& settings);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Each worker owns a task deque: it pops its own work from the back
+// and steals from the front of the other queues when it runs dry. Threads waiting on a
+// ParallelFor keep executing tasks, so ParallelFor can be nested inside a task.
+class JobSystem
+{
+public:
+    // workerCount = 0 uses one worker per hardware thread, minus the calling thread
+    JobSystem(int workerCount = 0);
+    ~JobSystem();
+
+    // Threads taking part in a ParallelFor: the workers plus the calling thread
+    int GetThreadCount() const;
+
+    // Calls body(begin, end) over [0, count) in chunks of grainSize and blocks until all chunks are done
+    void ParallelFor(int count, int grainSize, const std::function<void(int begin, int end)>& body);
+
+private:
+    struct Task
+    {
+        const std::function<void(int, int)>* body;
+        int begin;
+        int end;
+        std::atomic<int>* remaining;
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void WorkerLoop(int workerIndex);
+    bool TryRunTask(int queueIndex);
+    bool PopTask(int queueIndex, Task& outTask);
+    bool StealTask(int thiefIndex, Task& outTask);
+
+    std::vector<std::thread> workers;
+    std::vector<WorkerQueue> queues; // One per worker, plus one for external callers
+    std::atomic<int> pendingTasks;
+    std::atomic<bool> stopping;
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<unsigned int> nextQueue;
+};
@@ -2,7 +2,8 @@
 
 #include <cmath>
 
-struct Matrix4x4
+// Row-major, 16-byte aligned so rows can be loaded directly into SIMD registers
+struct alignas(16) Matrix4x4
 {
     float data[16];
 
@@ -34,6 +35,9 @@ struct Quaternion
     Quaternion operator+(const Quaternion& other) const;
     Quaternion operator-(const Quaternion& other) const;
     Quaternion operator*(float scalar) const;
+    Quaternion operator*(const Quaternion& other) const;
+
+    static Quaternion FromAxisAngle(const Vector3& axis, float angleRadians);
 };
 
 struct Transform
@@ -50,11 +54,50 @@ struct Transform
     Transform operator*(float scalar) const;
 };
 
+// Row-major affine matrix (the top three rows of a Matrix4x4), used as skinning output
+struct Matrix3x4
+{
+    float data[12];
+
+    Matrix3x4();
+};
+
+// Vector functions
+float Dot(const Vector3& a, const Vector3& b);
+Vector3 Cross(const Vector3& a, const Vector3& b);
+float Length(const Vector3& vector);
+Vector3 Normalize(const Vector3& vector);
+
+// Transform composition
+Vector3 Rotate(const Quaternion& rotation, const Vector3& vector);
+Transform Combine(const Transform& parent, const Transform& local);
+Transform Inverse(const Transform& transform); // Exact for uniform scale
+Matrix3x4 ToMatrix3x4(const Transform& transform);
+Matrix4x4 ToMatrix4x4(const Transform& transform);
+// Exact for translation, rotation and scale, mirrors included (as a negative X scale); shear is not representable and is lost
+Transform ToTransform(const Matrix4x4& matrix);
+
+// Batched results[i] = parents[i] * locals[i], dispatched to the widest SIMD path the CPU supports
+void MultiplyMatrices(const Matrix4x4* parents, const Matrix4x4* locals, Matrix4x4* results, int count);
+void MultiplyMatricesScalar(const Matrix4x4* parents, const Matrix4x4* locals, Matrix4x4* results, int count);
+
 // Lerp functions
 float Lerp(float a, float b, float t);
 Vector3 Lerp(const Vector3& a, const Vector3& b, float t);
 Quaternion Lerp(const Quaternion& a, const Quaternion& b, float t);
 Transform Lerp(const Transform& a, const Transform& b, float t);
 
+// Rotation blending
+// Nlerp and Slerp take the shortest path (b is flipped into a's hemisphere) and return unit quaternions
+float Dot(const Quaternion& a, const Quaternion& b);
+Quaternion Normalize(const Quaternion& q);
+Quaternion Conjugate(const Quaternion& q);
+Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t);
+Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t);
+
+// Approximate slerp (nlerp with a polynomial-corrected t), SIMD over 4 quaternions at a time
+Quaternion SlerpApproximate(const Quaternion& a, const Quaternion& b, float t);
+void SlerpBatch(const Quaternion* from, const Quaternion* to, float t, Quaternion* results, int count);
+
 // Clamp functions
 float Clamp(float value, float min, float max);
\ No newline at end of file
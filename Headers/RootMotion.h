@@ -0,0 +1,36 @@
+#pragma once
+
+#include "MathsUtils.h"
+
+// Root displacement in the character's own frame, Y up: a translation followed by a turn about Y.
+// 16 bytes, stored as is in clips and animation files.
+struct RootMotion
+{
+    Vector3 translation;
+    float yaw = 0.0f;
+
+    RootMotion();
+    RootMotion(const Vector3& _translation, float _yaw);
+
+    // Component-wise, for weighted blends of short deltas
+    RootMotion operator+(const RootMotion& other) const;
+    RootMotion operator*(float scalar) const;
+};
+
+// first, then second expressed in the frame first ends in
+RootMotion Combine(const RootMotion& first, const RootMotion& second);
+RootMotion Inverse(const RootMotion& motion);
+Vector3 RotateYaw(float yaw, const Vector3& vector);
+
+// Heading of a rotation: the angle of its forward (+Z) axis about Y
+float GetYaw(const Quaternion& rotation);
+
+// Integrates per-frame root motion deltas into a world position and heading
+struct RootMotionAccumulator
+{
+    Vector3 position;
+    float yaw = 0.0f;
+
+    void Apply(const RootMotion& delta);
+    Transform GetTransform() const;
+};
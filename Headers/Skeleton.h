@@ -4,21 +4,103 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <iostream>
 
+// 32-bit FNV-1a, usable at compile time
+constexpr uint32_t HashBoneName(std::string_view name)
+{
+    uint32_t hash = 2166136261u;
+    for (char c : name)
+    {
+        hash ^= (uint8_t)c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Bone name hashed at compile time, so hot code can look bones up without touching strings:
+// static constexpr BoneId Hand("Hand");
+struct BoneId
+{
+    uint32_t hash;
+
+    constexpr explicit BoneId(std::string_view name) : hash(HashBoneName(name)) {}
+};
+
+// Contiguous range [begin, end) of the skeleton's depth-first update order
+struct BoneSpan
+{
+    int begin;
+    int end;
+};
+
 class Skeleton
 {
 public:
     int AddBone(const std::string& name, int parentIndex, const Matrix4x4& localTransform);
-    int FindBone(const std::string& name);
+    int AddBone(const std::string& name, int parentIndex, const Transform& localTransform);
+    int FindBone(std::string_view name) const;
+    int FindBone(BoneId id) const;
+    // Matrix API: converts to and from the stored TRS poses, so matrices are only built when asked for.
+    // Local matrices must be TRS-decomposable (see ToTransform); mirrors round-trip, shear does not.
     void UpdateWorldTransforms();
     Matrix4x4 GetWorldTransform(int boneIndex);
     void SetLocalTransform(int boneIndex, const Matrix4x4& newTransform);
+    void SetLocalTransform(int boneIndex, const Transform& newTransform);
     void ShowBonesTransform();
 
+    // TRS path: composes local Transforms directly and only converts to affine matrices for skinning
+    void UpdateWorldPoses();
+    Transform GetWorldPose(int boneIndex);
+    void GetSkinningMatrices(std::vector<Matrix3x4>& outMatrices);
+
+    int GetBoneCount() const;
+    const std::string& GetBoneName(int boneIndex) const;
+    int GetParentIndex(int boneIndex) const;
+    // Parent used for propagation: -1 for bone 0 and for bones whose parent is out of range or the bone itself
+    int GetUpdateParent(int boneIndex) const;
+    Matrix4x4 GetLocalTransform(int boneIndex) const;
+    Transform GetLocalPose(int boneIndex) const;
+
+    // Parallel propagation: splits the hierarchy into ancestor bones to update first (parent-first order)
+    // and independent subtree spans of at most maxSpanBones bones that can then be updated concurrently
+    void SplitWorldPoseUpdate(int maxSpanBones, std::vector<int>& outSerialBones, std::vector<BoneSpan>& outSpans);
+
+    // Recomputes the dirty bones of a parent-first list; their children outside the list are left dirty
+    void UpdateWorldPoses(const int* bones, int count);
+
+    // Ancestor closure of bones in update order: the only bones to sample, blend and propagate
+    // for those bones' world poses to be exact (e.g. hitboxes and sockets on a headless server)
+    void GetRequiredBones(const int* bones, int count, std::vector<int>& outBones);
+    void UpdateWorldPoses(const BoneSpan& span);
+
+    // Number of bones recomputed by the last UpdateWorldTransforms or UpdateWorldPoses call
+    int GetLastUpdatedBoneCount() const;
+
 private:
+    void MarkDirty(int boneIndex);
+    void MarkChildrenDirty(int position);
+    void InsertBoneHash(int boneIndex);
+    void RebuildUpdateOrder();
+
     std::vector<std::string> bonesName;
     std::vector<int> bonesParentIndex;
-    std::vector<Matrix4x4> bonesLocalTransform;
-    std::vector<Matrix4x4> bonesWorldTransform;
+    std::vector<Transform> bonesLocalPose;
+    std::vector<Transform> bonesWorldPose;
+    std::vector<unsigned char> bonesDirty;
+
+    // Open-addressing name index (linear probing, power-of-two size, at most half full).
+    // Two different names with the same hash resolve to the first bone added for FindBone(BoneId).
+    std::vector<uint32_t> boneHashSlots;
+    std::vector<int> boneIndexSlots;
+
+    // Depth-first bone order: the subtree starting at position p is the contiguous span [p, bonesSubtreeEnd[p])
+    std::vector<int> bonesUpdateOrder;
+    std::vector<int> bonesSubtreeEnd;
+    std::vector<int> bonesUpdateParent;
+    std::vector<int> bonesUpdatePosition;
+    bool updateOrderDirty = true;
+    int lastUpdatedBoneCount = 0;
 };
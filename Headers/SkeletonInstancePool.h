@@ -0,0 +1,38 @@
+#pragma once
+
+#include "MathsUtils.h"
+#include "Skeleton.h"
+
+#include <vector>
+
+// Shares one Skeleton topology across many instances.
+// Bones are stored parent-first and instances are packed per bone (bone-major),
+// so each bone reads its parent slice once for every instance.
+class SkeletonInstancePool
+{
+public:
+    SkeletonInstancePool(const Skeleton& skeleton, int instanceCount);
+
+    void SetInstanceCount(int newInstanceCount);
+    int GetInstanceCount() const;
+    int GetBoneCount() const;
+
+    void SetLocalTransform(int instanceIndex, int boneIndex, const Matrix4x4& newTransform);
+    Matrix4x4 GetWorldTransform(int instanceIndex, int boneIndex) const;
+    void UpdateWorldTransforms();
+
+private:
+    int boneCount;
+    int instanceCount;
+
+    // Indexed by sorted slot
+    std::vector<int> sortedParentIndex;
+    std::vector<Matrix4x4> bindLocalTransform;
+
+    // Skeleton bone index -> sorted slot
+    std::vector<int> boneToSortedIndex;
+
+    // [sortedSlot * instanceCount + instanceIndex]
+    std::vector<Matrix4x4> localTransforms;
+    std::vector<Matrix4x4> worldTransforms;
+};
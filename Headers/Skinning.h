@@ -0,0 +1,70 @@
+#pragma once
+
+#include "MathsUtils.h"
+#include "Skeleton.h"
+
+#include <cstdint>
+#include <vector>
+
+// Vertex positions and normals in Structure of Arrays layout, so 4 vertices fill one SIMD register
+struct VertexStream
+{
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> normalX, normalY, normalZ;
+
+    int GetVertexCount() const;
+    void Resize(int vertexCount);
+    void SetVertex(int index, const Vector3& position, const Vector3& normal);
+    Vector3 GetPosition(int index) const;
+    Vector3 GetNormal(int index) const;
+};
+
+// Bind-pose vertices and their bone influences.
+// Influences are stored influence-major: influence i of vertex v is at [i * vertexCount + v].
+struct SkinnedMesh
+{
+    VertexStream bindVertices;
+    int influenceCount = 4;
+
+    // Size of the palettes the influences index into
+    int boneCount = 0;
+    std::vector<uint16_t> boneIndices;
+    std::vector<float> boneWeights;
+
+    int GetVertexCount() const;
+
+    // 4 and 8 influences run unrolled SIMD kernels, other counts a scalar loop.
+    // Every influence starts on bone 0 with weight 0. boneCount is capped at 65536, the range of a bone index.
+    void Resize(int vertexCount, int influenceCount, int boneCount);
+
+    // Ignored when the vertex, influence or bone is out of range
+    void SetInfluence(int vertex, int influence, int bone, float weight);
+
+    // Scales each vertex's weights to sum to 1
+    void NormalizeWeights();
+};
+
+// Rigid transform as a unit dual quaternion: real is the rotation, dual encodes the translation
+struct DualQuaternion
+{
+    Quaternion real;
+    Quaternion dual;
+};
+
+DualQuaternion ToDualQuaternion(const Quaternion& rotation, const Vector3& translation);
+
+// Inverse of every bone's current world pose (call UpdateWorldPoses first), taken as the bind pose
+void ComputeInverseBindPose(Skeleton& skeleton, std::vector<Transform>& outInverseBindPose);
+
+// Per-bone world * inverse bind, from the skeleton's current world poses
+void BuildSkinningPalette(Skeleton& skeleton, const std::vector<Transform>& inverseBindPose, std::vector<Matrix3x4>& outPalette);
+
+// Dual-quaternion palette: no volume loss at twisted joints, but bone scale is ignored
+void BuildDualQuaternionPalette(Skeleton& skeleton, const std::vector<Transform>& inverseBindPose, std::vector<DualQuaternion>& outPalette);
+
+// Deform vertices [begin, end) into outVertices, which must already hold the mesh's vertex count,
+// with palettes of at least mesh.boneCount entries.
+// Disjoint ranges touch disjoint memory, so ranges can be skinned on different threads.
+// Linear skinning transforms normals by the cofactor of the blended matrix, so non-uniform bone scale keeps them perpendicular.
+void SkinVerticesLinear(const SkinnedMesh& mesh, const Matrix3x4* palette, int begin, int end, VertexStream& outVertices);
+void SkinVerticesDualQuaternion(const SkinnedMesh& mesh, const DualQuaternion* palette, int begin, int end, VertexStream& outVertices);
@@ -1,23 +1,115 @@
 #pragma once
 
 #include <string>
-#include <functional>
 #include <vector>
+#include <cstdint>
+#include <initializer_list>
 
 enum State { Idle, Walk, Run, Jump, Any };
 
+// Wildcard source state in a StateMachineGraph
+static const int AnyState = -1;
+static const int MaxStateMachineParameters = 8;
+
+enum ConditionOp : uint8_t
+{
+    Greater,
+    GreaterEqual,
+    Less,
+    LessEqual,
+    Equal,
+    NotEqual
+};
+
+// Shape of a cross-fade's weight over its normalized time
+enum BlendCurve : uint8_t
+{
+    CurveLinear,
+    CurveSmoothStep,
+    CurveEaseIn,
+    CurveEaseOut
+};
+
+float EvaluateBlendCurve(BlendCurve curve, float t);
+
+// Compiled condition: compares one instance parameter against a constant
+struct TransitionCondition
+{
+    uint8_t parameter;
+    ConditionOp op;
+    float value;
+};
+
+// Fires when every one of its conditions holds; transitions are tested in declaration order
 struct Transition
 {
-    State from;
-    State to;
-    std::function<bool()> condition;
+    int from;
+    int to;
+    int firstCondition;
+    int conditionCount;
+
+    // Cross-fade length in seconds, 0 snaps to the target state
+    float duration;
+    BlendCurve curve;
 };
 
-class StateMachine
+// Per-instance state: plain data, no pointers, cheap to copy and to store in bulk
+struct StateMachineInstance
 {
+    int currentState;
+    float parameters[MaxStateMachineParameters];
+
+    // Active cross-fade from previousState into currentState, previousState is -1 when none
+    int previousState;
+    float transitionTime;
+    float transitionDuration;
+    BlendCurve transitionCurve;
+
+    bool isTransitioning() const;
+
+    // Weight of currentState in the cross-fade, after the curve; 1 when not transitioning
+    float getTransitionWeight() const;
+};
+
+// Data-driven state graph shared by every instance that uses it
+class StateMachineGraph
+{
+public:
+    int addState(const std::string& name);
+    int addParameter(const std::string& name);
+    void addTransition(int from, int to, std::initializer_list<TransitionCondition> conditions, float duration = 0.0f, BlendCurve curve = CurveLinear);
+
+    int getStateCount() const;
+    const std::string& getStateName(int state) const;
+    int findParameter(const std::string& name) const;
+
+    StateMachineInstance createInstance(int initialState) const;
+    // Advances any active cross-fade by deltaTime, then fires the first transition whose conditions hold
+    void update(StateMachineInstance& instance, float deltaTime = 0.0f) const;
+
+    // Evaluates transitions for many instances at once, in fixed-size blocks whose inner loops vectorize
+    void updateAll(StateMachineInstance* instances, int count, float deltaTime = 0.0f) const;
+
 private:
-    State currentState;
+    void rebuildStateTransitions();
+    static void advanceTransition(StateMachineInstance& instance, float deltaTime);
+    static void startTransition(StateMachineInstance& instance, const Transition& transition);
+
+    std::vector<std::string> stateNames;
+    std::vector<std::string> parameterNames;
     std::vector<Transition> transitions;
+    std::vector<TransitionCondition> conditions;
+
+    // Transitions reachable from each state (its own and AnyState ones), in declaration order
+    std::vector<int> stateTransitionStart;
+    std::vector<int> stateTransitionIndices;
+};
+
+// Locomotion state machine (Idle, Walk, Run, Jump) built on a shared StateMachineGraph
+class StateMachine
+{
+private:
+    StateMachineInstance instance;
 
 public:
     float speed;
@@ -25,5 +117,13 @@ public:
 
     StateMachine(State _BaseState);
     std::string getCurrentState();
-    void update();
+    void update(float deltaTime = 0.0f);
+
+    // Cross-fade source, "Unknown" when not transitioning
+    std::string getPreviousState();
+    bool isTransitioning() const;
+    float getTransitionWeight() const;
+    const StateMachineInstance& getInstance() const;
+
+    static const StateMachineGraph& getLocomotionGraph();
 };
@@ -1,5 +1,7 @@
 #include "../Headers/AnimationBlending.h"
 
+#include <algorithm>
+
 Pose::Pose()
 {
 
@@ -10,45 +12,568 @@ Pose::Pose(int boneCount, const Transform& defaultTransform)
     boneTransforms.resize(boneCount, defaultTransform);
 }
 
-// Blend poses with weights
-Pose BlendPoses(const std::vector<Pose>& poses, std::vector<float> weights)
+PoseSoA::PoseSoA()
 {
-    if (poses.size() != weights.size())
+
+}
+
+PoseSoA::PoseSoA(int boneCount)
+{
+    Resize(boneCount);
+}
+
+int PoseSoA::GetBoneCount() const
+{
+    return rotations.size() / 4;
+}
+
+void PoseSoA::Resize(int boneCount)
+{
+    positions.resize(boneCount * 3);
+    rotations.resize(boneCount * 4);
+    scales.resize(boneCount * 3);
+}
+
+void ToPoseSoA(const Pose& pose, PoseSoA& outPose)
+{
+    int boneCount = pose.boneTransforms.size();
+    outPose.Resize(boneCount);
+
+    for (int i = 0; i < boneCount; i++)
     {
-        return Pose();
+        const Transform& transform = pose.boneTransforms[i];
+
+        outPose.positions[i * 3 + 0] = transform.position.x;
+        outPose.positions[i * 3 + 1] = transform.position.y;
+        outPose.positions[i * 3 + 2] = transform.position.z;
+
+        outPose.rotations[i * 4 + 0] = transform.rotation.x;
+        outPose.rotations[i * 4 + 1] = transform.rotation.y;
+        outPose.rotations[i * 4 + 2] = transform.rotation.z;
+        outPose.rotations[i * 4 + 3] = transform.rotation.w;
+
+        outPose.scales[i * 3 + 0] = transform.scale.x;
+        outPose.scales[i * 3 + 1] = transform.scale.y;
+        outPose.scales[i * 3 + 2] = transform.scale.z;
+    }
+}
+
+void ToPose(const PoseSoA& pose, Pose& outPose)
+{
+    int boneCount = pose.GetBoneCount();
+    outPose.boneTransforms.resize(boneCount);
+
+    for (int i = 0; i < boneCount; i++)
+    {
+        outPose.boneTransforms[i] = Transform(
+            Vector3(pose.positions[i * 3 + 0], pose.positions[i * 3 + 1], pose.positions[i * 3 + 2]),
+            Quaternion(pose.rotations[i * 4 + 0], pose.rotations[i * 4 + 1], pose.rotations[i * 4 + 2], pose.rotations[i * 4 + 3]),
+            Vector3(pose.scales[i * 3 + 0], pose.scales[i * 3 + 1], pose.scales[i * 3 + 2])
+        );
     }
+}
 
+// Sum of clamped weights, or 0 when the blend is degenerate
+static float GetTotalWeight(const float* weights, int count)
+{
     float totalWeights = 0.0f;
-    for (int i = 0; i < weights.size(); i++)
+    for (int i = 0; i < count; i++)
+    {
+        if (weights[i] > 0.0f)
+        {
+            totalWeights += weights[i];
+        }
+    }
+
+    return totalWeights;
+}
+
+// Weighted sum of one flat stream into another, written so the compiler can vectorize it
+static void AccumulateStream(const float* source, float weight, float* destination, int count, bool overwrite)
+{
+    if (overwrite)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            destination[i] = source[i] * weight;
+        }
+        return;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        destination[i] += source[i] * weight;
+    }
+}
+
+// Sign-corrected weighted sum of quaternion streams (x, y, z, w per bone)
+static void AccumulateRotations(const float* source, float weight, float* destination, int boneCount, bool overwrite)
+{
+    if (overwrite)
+    {
+        AccumulateStream(source, weight, destination, boneCount * 4, true);
+        return;
+    }
+
+    for (int i = 0; i < boneCount; i++)
+    {
+        const float* from = &source[i * 4];
+        float* to = &destination[i * 4];
+
+        float dot = from[0] * to[0] + from[1] * to[1] + from[2] * to[2] + from[3] * to[3];
+        float rotationWeight = dot < 0.0f ? -weight : weight;
+
+        to[0] += from[0] * rotationWeight;
+        to[1] += from[1] * rotationWeight;
+        to[2] += from[2] * rotationWeight;
+        to[3] += from[3] * rotationWeight;
+    }
+}
+
+static void NormalizeRotations(float* rotations, int boneCount)
+{
+    for (int i = 0; i < boneCount; i++)
     {
-        if (weights[i] < 0.0f)
+        float* q = &rotations[i * 4];
+        float lengthSquared = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+
+        if (lengthSquared == 0.0f)
         {
-            weights[i] = 0.0f;
+            q[0] = 0.0f;
+            q[1] = 0.0f;
+            q[2] = 0.0f;
+            q[3] = 1.0f;
+            continue;
         }
 
-        totalWeights += weights[i];
+        float inverseLength = 1.0f / std::sqrt(lengthSquared);
+        q[0] *= inverseLength;
+        q[1] *= inverseLength;
+        q[2] *= inverseLength;
+        q[3] *= inverseLength;
     }
+}
+
+Pose BlendPoses(const std::vector<Pose>& poses, const std::vector<float>& weights)
+{
+    Pose result = Pose();
+    BlendPoses(poses, weights, result);
+    return result;
+}
 
+void BlendPoses(const std::vector<Pose>& poses, const std::vector<float>& weights, Pose& outPose)
+{
+    if (poses.size() != weights.size())
+    {
+        outPose.boneTransforms.clear();
+        return;
+    }
+
+    // Blend through a small fixed buffer of pointers to stay allocation-free for typical fan-outs
+    const int MaxStackPoses = 16;
+    const Pose* posePointers[MaxStackPoses];
+
+    if (poses.size() <= MaxStackPoses)
+    {
+        for (int i = 0; i < poses.size(); i++)
+        {
+            posePointers[i] = &poses[i];
+        }
+
+        BlendPoses(posePointers, weights.data(), poses.size(), outPose);
+        return;
+    }
+
+    std::vector<const Pose*> heapPointers(poses.size());
+    for (int i = 0; i < poses.size(); i++)
+    {
+        heapPointers[i] = &poses[i];
+    }
+
+    BlendPoses(heapPointers.data(), weights.data(), poses.size(), outPose);
+}
+
+// Pose-major accumulation: each source pose is streamed once and zero-weight poses are skipped.
+// source(j) gives the transforms of pose j, so Pose and raw-array callers share the loop.
+template <typename GetSource>
+static void BlendAllBones(GetSource source, const float* weights, int poseCount, float totalWeights, int boneCount, Transform* destination)
+{
+    bool first = true;
+    for (int j = 0; j < poseCount; j++)
+    {
+        if (weights[j] <= 0.0f)
+        {
+            continue;
+        }
+
+        float weight = weights[j] / totalWeights;
+        const Transform* from = source(j);
+
+        for (int i = 0; i < boneCount; i++)
+        {
+            Transform& to = destination[i];
+
+            if (first)
+            {
+                to.position = from[i].position * weight;
+                to.rotation = from[i].rotation * weight;
+                to.scale = from[i].scale * weight;
+                continue;
+            }
+
+            to.position.x += from[i].position.x * weight;
+            to.position.y += from[i].position.y * weight;
+            to.position.z += from[i].position.z * weight;
+
+            // Flip into the accumulated rotation's hemisphere so opposite-signed quaternions don't cancel out
+            float rotationWeight = Dot(to.rotation, from[i].rotation) < 0.0f ? -weight : weight;
+            to.rotation.x += from[i].rotation.x * rotationWeight;
+            to.rotation.y += from[i].rotation.y * rotationWeight;
+            to.rotation.z += from[i].rotation.z * rotationWeight;
+            to.rotation.w += from[i].rotation.w * rotationWeight;
+
+            to.scale.x += from[i].scale.x * weight;
+            to.scale.y += from[i].scale.y * weight;
+            to.scale.z += from[i].scale.z * weight;
+        }
+
+        first = false;
+    }
+
+    // Single normalize per bone once every pose has been accumulated
+    for (int i = 0; i < boneCount; i++)
+    {
+        destination[i].rotation = Normalize(destination[i].rotation);
+    }
+}
+
+// Bone-major: a sparse bone list touches each source pose only at the listed bones
+template <typename GetSource>
+static void BlendBoneList(GetSource source, const float* weights, int poseCount, int boneCount, const int* bones, int count, Transform* destination)
+{
+    float totalWeights = GetTotalWeight(weights, poseCount);
+
+    for (int i = 0; i < count; i++)
+    {
+        int bone = bones[i];
+        if (bone < 0 || bone >= boneCount)
+        {
+            continue;
+        }
+
+        Transform& to = destination[bone];
+        if (totalWeights == 0.0f)
+        {
+            to = source(0)[bone];
+            continue;
+        }
+
+        bool first = true;
+        for (int j = 0; j < poseCount; j++)
+        {
+            if (weights[j] <= 0.0f)
+            {
+                continue;
+            }
+
+            float weight = weights[j] / totalWeights;
+            const Transform& from = source(j)[bone];
+
+            if (first)
+            {
+                to.position = from.position * weight;
+                to.rotation = from.rotation * weight;
+                to.scale = from.scale * weight;
+                first = false;
+                continue;
+            }
+
+            to.position = to.position + from.position * weight;
+            to.rotation = to.rotation + from.rotation * (Dot(to.rotation, from.rotation) < 0.0f ? -weight : weight);
+            to.scale = to.scale + from.scale * weight;
+        }
+
+        to.rotation = Normalize(to.rotation);
+    }
+}
+
+void BlendPoses(const Pose* const* poses, const float* weights, int poseCount, Pose& outPose)
+{
+    if (poseCount <= 0)
+    {
+        outPose.boneTransforms.clear();
+        return;
+    }
+
+    float totalWeights = GetTotalWeight(weights, poseCount);
     if (totalWeights == 0.0f)
     {
-        return poses[0];
+        outPose.boneTransforms = poses[0]->boneTransforms;
+        return;
+    }
+
+    int boneCount = poses[0]->boneTransforms.size();
+    outPose.boneTransforms.resize(boneCount);
+    BlendAllBones([poses](int j) { return poses[j]->boneTransforms.data(); }, weights, poseCount, totalWeights, boneCount, outPose.boneTransforms.data());
+}
+
+void BlendPoses(const Pose* const* poses, const float* weights, int poseCount, const int* bones, int count, Pose& outPose)
+{
+    if (poseCount <= 0)
+    {
+        outPose.boneTransforms.clear();
+        return;
     }
 
+    int boneCount = poses[0]->boneTransforms.size();
+    outPose.boneTransforms.resize(boneCount);
+    BlendBoneList([poses](int j) { return poses[j]->boneTransforms.data(); }, weights, poseCount, boneCount, bones, count, outPose.boneTransforms.data());
+}
+
+void BlendPoses(const Transform* const* poses, const float* weights, int poseCount, int boneCount, const int* bones, int count, Transform* outTransforms)
+{
+    if (poseCount <= 0)
+    {
+        return;
+    }
+
+    if (bones != nullptr)
+    {
+        BlendBoneList([poses](int j) { return poses[j]; }, weights, poseCount, boneCount, bones, count, outTransforms);
+        return;
+    }
+
+    float totalWeights = GetTotalWeight(weights, poseCount);
+    if (totalWeights == 0.0f)
+    {
+        std::copy(poses[0], poses[0] + boneCount, outTransforms);
+        return;
+    }
+
+    BlendAllBones([poses](int j) { return poses[j]; }, weights, poseCount, totalWeights, boneCount, outTransforms);
+}
+
+void BlendPoses(const std::vector<PoseSoA>& poses, const std::vector<float>& weights, PoseSoA& outPose)
+{
+    if (poses.empty() || poses.size() != weights.size())
+    {
+        outPose.Resize(0);
+        return;
+    }
+
+    float totalWeights = GetTotalWeight(weights.data(), weights.size());
+    if (totalWeights == 0.0f)
+    {
+        outPose = poses[0];
+        return;
+    }
+
+    int boneCount = poses[0].GetBoneCount();
+    outPose.Resize(boneCount);
+
+    bool first = true;
+    for (int j = 0; j < poses.size(); j++)
+    {
+        if (weights[j] <= 0.0f)
+        {
+            continue;
+        }
+
+        float weight = weights[j] / totalWeights;
+
+        AccumulateStream(poses[j].positions.data(), weight, outPose.positions.data(), boneCount * 3, first);
+        AccumulateRotations(poses[j].rotations.data(), weight, outPose.rotations.data(), boneCount, first);
+        AccumulateStream(poses[j].scales.data(), weight, outPose.scales.data(), boneCount * 3, first);
+
+        first = false;
+    }
+
+    NormalizeRotations(outPose.rotations.data(), boneCount);
+}
+
+BoneMask::BoneMask()
+{
+}
+
+BoneMask::BoneMask(int boneCount, float weight) : weights(boneCount, weight)
+{
+    RebuildRanges();
+}
+
+int BoneMask::GetBoneCount() const
+{
+    return weights.size();
+}
+
+void BoneMask::SetBoneWeight(int boneIndex, float weight)
+{
+    if (boneIndex < 0 || boneIndex >= weights.size())
+    {
+        return;
+    }
+
+    weights[boneIndex] = weight;
+    RebuildRanges();
+}
+
+void BoneMask::SetSubtreeWeight(const Skeleton& skeleton, int rootBone, float weight)
+{
+    int boneCount = skeleton.GetBoneCount();
+    if (rootBone < 0 || rootBone >= boneCount)
+    {
+        return;
+    }
+
+    weights.resize(boneCount, 0.0f);
+
+    // Walks the propagation parents, bounded so a cycle in the raw parent indices cannot hang it
+    for (int i = 0; i < boneCount; i++)
+    {
+        int ancestor = i;
+        for (int depth = 0; ancestor >= 0 && ancestor != rootBone && depth < boneCount; depth++)
+        {
+            ancestor = skeleton.GetUpdateParent(ancestor);
+        }
+
+        if (ancestor == rootBone)
+        {
+            weights[i] = weight;
+        }
+    }
+
+    RebuildRanges();
+}
+
+void BoneMask::RebuildRanges()
+{
+    ranges.clear();
+
     for (int i = 0; i < weights.size(); i++)
     {
-        weights[i] = weights[i] / totalWeights;
+        if (weights[i] <= 0.0f)
+        {
+            continue;
+        }
+
+        if (!ranges.empty() && ranges.back().end == i)
+        {
+            ranges.back().end = i + 1;
+        }
+        else
+        {
+            ranges.push_back({ i, i + 1 });
+        }
     }
+}
 
-    Pose result = Pose();
-    result.boneTransforms.resize(poses[0].boneTransforms.size(), Transform());
+BoneMask CreateBoneMask(const Skeleton& skeleton, int rootBone, float weight)
+{
+    BoneMask mask(skeleton.GetBoneCount(), 0.0f);
+    mask.SetSubtreeWeight(skeleton, rootBone, weight);
+    return mask;
+}
+
+void BlendPoseLayer(Pose& pose, const Pose& layerPose, float weight, const BoneMask& mask)
+{
+    int boneCount = std::min(pose.boneTransforms.size(), layerPose.boneTransforms.size());
 
-    for (int i = 0; i < result.boneTransforms.size(); i++)
+    for (const BoneSpan& range : mask.ranges)
     {
-        for (int j = 0; j < weights.size(); j++)
+        int end = std::min(range.end, boneCount);
+        for (int i = range.begin; i < end; i++)
         {
-            result.boneTransforms[i] = result.boneTransforms[i] + (poses[j].boneTransforms[i] * weights[j]);
+            Transform& to = pose.boneTransforms[i];
+            const Transform& from = layerPose.boneTransforms[i];
+            float t = weight * mask.weights[i];
+
+            to.position = Lerp(to.position, from.position, t);
+            to.rotation = Nlerp(to.rotation, from.rotation, t);
+            to.scale = Lerp(to.scale, from.scale, t);
         }
     }
+}
 
-    return result;
+static inline Transform MakeAdditiveTransform(const Transform& transform, const Transform& reference)
+{
+    Transform delta = transform - reference;
+    delta.rotation = Conjugate(reference.rotation) * transform.rotation;
+    return delta;
+}
+
+static inline void AddAdditiveTransform(Transform& transform, const Transform& delta, float weight)
+{
+    transform.position = transform.position + delta.position * weight;
+    transform.scale = transform.scale + delta.scale * weight;
+    transform.rotation = Normalize(transform.rotation * Nlerp(Quaternion(), delta.rotation, weight));
+}
+
+void MakeAdditivePose(const Pose& pose, const Pose& referencePose, Pose& outDelta)
+{
+    int boneCount = std::min(pose.boneTransforms.size(), referencePose.boneTransforms.size());
+    outDelta.boneTransforms.resize(boneCount);
+
+    for (int i = 0; i < boneCount; i++)
+    {
+        outDelta.boneTransforms[i] = MakeAdditiveTransform(pose.boneTransforms[i], referencePose.boneTransforms[i]);
+    }
+}
+
+void AddAdditivePose(Pose& pose, const Pose& delta, float weight)
+{
+    int boneCount = std::min(pose.boneTransforms.size(), delta.boneTransforms.size());
+
+    for (int i = 0; i < boneCount; i++)
+    {
+        AddAdditiveTransform(pose.boneTransforms[i], delta.boneTransforms[i], weight);
+    }
+}
+
+void AddAdditivePose(Pose& pose, const Pose& delta, float weight, const BoneMask& mask)
+{
+    int boneCount = std::min(pose.boneTransforms.size(), delta.boneTransforms.size());
+
+    for (const BoneSpan& range : mask.ranges)
+    {
+        int end = std::min(range.end, boneCount);
+        for (int i = range.begin; i < end; i++)
+        {
+            AddAdditiveTransform(pose.boneTransforms[i], delta.boneTransforms[i], weight * mask.weights[i]);
+        }
+    }
+}
+
+void ApplyAdditivePose(const Pose& basePose, const Pose& additivePose, const Pose& referencePose, float weight, Pose& outPose)
+{
+    int boneCount = std::min(basePose.boneTransforms.size(), std::min(additivePose.boneTransforms.size(), referencePose.boneTransforms.size()));
+
+    if (&outPose != &basePose)
+    {
+        outPose.boneTransforms = basePose.boneTransforms;
+    }
+
+    for (int i = 0; i < boneCount; i++)
+    {
+        Transform delta = MakeAdditiveTransform(additivePose.boneTransforms[i], referencePose.boneTransforms[i]);
+        AddAdditiveTransform(outPose.boneTransforms[i], delta, weight);
+    }
+}
+
+void ApplyAdditivePose(const Pose& basePose, const Pose& additivePose, const Pose& referencePose, float weight, const BoneMask& mask, Pose& outPose)
+{
+    int boneCount = std::min(basePose.boneTransforms.size(), std::min(additivePose.boneTransforms.size(), referencePose.boneTransforms.size()));
+
+    if (&outPose != &basePose)
+    {
+        outPose.boneTransforms = basePose.boneTransforms;
+    }
+
+    for (const BoneSpan& range : mask.ranges)
+    {
+        int end = std::min(range.end, boneCount);
+        for (int i = range.begin; i < end; i++)
+        {
+            Transform delta = MakeAdditiveTransform(additivePose.boneTransforms[i], referencePose.boneTransforms[i]);
+            AddAdditiveTransform(outPose.boneTransforms[i], delta, weight * mask.weights[i]);
+        }
+    }
 }
@@ -0,0 +1,420 @@
+#include "../Headers/AnimationClip.h"
+
+#include <algorithm>
+
+static const float SmallestThreeRange = 0.70710678f; // 1 / sqrt(2), bound of the three smallest components
+static const float SmallestThreeScale = 32767.0f;
+
+CompressedQuaternion CompressQuaternion(const Quaternion& rotation)
+{
+    Quaternion q = Normalize(rotation);
+    float components[4] = { q.x, q.y, q.z, q.w };
+
+    int largest = 0;
+    for (int i = 1; i < 4; i++)
+    {
+        if (std::abs(components[i]) > std::abs(components[largest]))
+        {
+            largest = i;
+        }
+    }
+
+    // q and -q are the same rotation: keep the dropped component positive
+    float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+    uint16_t quantized[3];
+    int slot = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        if (i == largest)
+        {
+            continue;
+        }
+
+        float normalized = (Clamp(components[i] * sign, -SmallestThreeRange, SmallestThreeRange) + SmallestThreeRange) / (2.0f * SmallestThreeRange);
+        quantized[slot++] = (uint16_t)(normalized * SmallestThreeScale + 0.5f);
+    }
+
+    CompressedQuaternion result;
+    result.data[0] = (uint16_t)(((largest >> 1) << 15) | quantized[0]);
+    result.data[1] = (uint16_t)(((largest & 1) << 15) | quantized[1]);
+    result.data[2] = quantized[2];
+    return result;
+}
+
+Quaternion DecompressQuaternion(const CompressedQuaternion& rotation)
+{
+    int largest = ((rotation.data[0] >> 15) << 1) | (rotation.data[1] >> 15);
+
+    float small[3];
+    for (int i = 0; i < 3; i++)
+    {
+        float normalized = (rotation.data[i] & 0x7FFF) / SmallestThreeScale;
+        small[i] = normalized * (2.0f * SmallestThreeRange) - SmallestThreeRange;
+    }
+
+    float sumSquares = small[0] * small[0] + small[1] * small[1] + small[2] * small[2];
+    float dropped = std::sqrt(std::max(0.0f, 1.0f - sumSquares));
+
+    float components[4];
+    int slot = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        components[i] = i == largest ? dropped : small[slot++];
+    }
+
+    return Quaternion(components[0], components[1], components[2], components[3]);
+}
+
+int AnimationClip::GetBoneCount() const
+{
+    return boneTracks.size();
+}
+
+size_t AnimationClip::GetMemoryUsage() const
+{
+    return sizeof(AnimationClip)
+        + boneTracks.size() * sizeof(BoneTrack)
+        + constantPositions.size() * sizeof(Vector3)
+        + constantRotations.size() * sizeof(CompressedQuaternion)
+        + constantScales.size() * sizeof(Vector3)
+        + positionKeys.size() * sizeof(Vector3)
+        + rotationKeys.size() * sizeof(CompressedQuaternion)
+        + scaleKeys.size() * sizeof(Vector3)
+        + rootMotionKeys.size() * sizeof(RootMotion);
+}
+
+AnimationClipView AnimationClip::GetView() const
+{
+    AnimationClipView view;
+
+    view.duration = duration;
+    view.sampleRate = sampleRate;
+    view.frameCount = frameCount;
+    view.boneCount = boneTracks.size();
+
+    view.animatedPositionCount = animatedPositionCount;
+    view.animatedRotationCount = animatedRotationCount;
+    view.animatedScaleCount = animatedScaleCount;
+
+    view.boneTracks = boneTracks.data();
+    view.constantPositions = constantPositions.data();
+    view.constantRotations = constantRotations.data();
+    view.constantScales = constantScales.data();
+    view.positionKeys = positionKeys.data();
+    view.rotationKeys = rotationKeys.data();
+    view.scaleKeys = scaleKeys.data();
+    view.rootMotionKeys = rootMotionKeys.empty() ? nullptr : rootMotionKeys.data();
+
+    return view;
+}
+
+static bool IsNearlyEqual(const Vector3& a, const Vector3& b, float tolerance)
+{
+    return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance && std::abs(a.z - b.z) <= tolerance;
+}
+
+// Rotation angle from a to b in radians, through atan2 so that angles near zero stay precise in float
+static float GetAngleBetween(const Quaternion& a, const Quaternion& b)
+{
+    Quaternion relative = Quaternion(-a.x, -a.y, -a.z, a.w) * b;
+    float sine = std::sqrt(relative.x * relative.x + relative.y * relative.y + relative.z * relative.z);
+    return 2.0f * std::atan2(sine, std::abs(relative.w));
+}
+
+// Moves the root bone's horizontal motion and heading, relative to frame 0, out of the frames into keys
+static void ExtractRootMotion(std::vector<Pose>& frames, int rootBone, std::vector<RootMotion>& outKeys)
+{
+    outKeys.resize(frames.size());
+    const Transform first = frames[0].boneTransforms[rootBone];
+    float firstYaw = GetYaw(first.rotation);
+    float previousYaw = 0.0f;
+
+    for (int frame = 0; frame < frames.size(); frame++)
+    {
+        Transform& root = frames[frame].boneTransforms[rootBone];
+
+        // Unwrapped, so a clip turning past 180 degrees keeps a continuous heading
+        float yaw = GetYaw(root.rotation) - firstYaw;
+        yaw = previousYaw + std::remainder(yaw - previousYaw, 2.0f * 3.14159265f);
+        previousYaw = yaw;
+
+        Vector3 offset = root.position - first.position;
+        outKeys[frame] = RootMotion(RotateYaw(-firstYaw, Vector3(offset.x, 0.0f, offset.z)), yaw);
+
+        root.position = Vector3(first.position.x, root.position.y, first.position.z);
+        root.rotation = Normalize(Quaternion::FromAxisAngle(Vector3(0.0f, 1.0f, 0.0f), -yaw) * root.rotation);
+    }
+}
+
+AnimationClip CreateAnimationClip(const std::string& name, float sampleRate, const std::vector<Pose>& sourceFrames, float tolerance, int rootMotionBone, float angularTolerance)
+{
+    bool hasRootMotion = !sourceFrames.empty() && rootMotionBone >= 0 && rootMotionBone < sourceFrames[0].boneTransforms.size();
+    std::vector<Pose> inPlaceFrames;
+    std::vector<RootMotion> rootMotionKeys;
+    if (hasRootMotion)
+    {
+        inPlaceFrames = sourceFrames;
+        ExtractRootMotion(inPlaceFrames, rootMotionBone, rootMotionKeys);
+    }
+    const std::vector<Pose>& frames = hasRootMotion ? inPlaceFrames : sourceFrames;
+
+    AnimationClip clip{ name, 0.0f };
+    clip.sampleRate = sampleRate;
+    clip.frameCount = frames.size();
+
+    if (frames.empty() || sampleRate <= 0.0f)
+    {
+        clip.frameCount = 0;
+        return clip;
+    }
+
+    clip.duration = (frames.size() - 1) / sampleRate;
+    clip.rootMotionKeys = rootMotionKeys;
+
+    int boneCount = frames[0].boneTransforms.size();
+    clip.boneTracks.resize(boneCount);
+
+    // Classify every channel as constant or animated
+    for (int bone = 0; bone < boneCount; bone++)
+    {
+        const Transform& first = frames[0].boneTransforms[bone];
+        bool positionAnimated = false;
+        bool rotationAnimated = false;
+        bool scaleAnimated = false;
+
+        for (int frame = 1; frame < frames.size(); frame++)
+        {
+            const Transform& current = frames[frame].boneTransforms[bone];
+
+            positionAnimated |= !IsNearlyEqual(current.position, first.position, tolerance);
+            rotationAnimated |= GetAngleBetween(Normalize(first.rotation), Normalize(current.rotation)) > angularTolerance;
+            scaleAnimated |= !IsNearlyEqual(current.scale, first.scale, tolerance);
+        }
+
+        BoneTrack& track = clip.boneTracks[bone];
+        track.animatedChannels = 0;
+
+        if (positionAnimated)
+        {
+            track.animatedChannels |= TrackPosition;
+            track.positionIndex = clip.animatedPositionCount++;
+        }
+        else
+        {
+            track.positionIndex = clip.constantPositions.size();
+            clip.constantPositions.push_back(first.position);
+        }
+
+        if (rotationAnimated)
+        {
+            track.animatedChannels |= TrackRotation;
+            track.rotationIndex = clip.animatedRotationCount++;
+        }
+        else
+        {
+            track.rotationIndex = clip.constantRotations.size();
+            clip.constantRotations.push_back(CompressQuaternion(first.rotation));
+        }
+
+        if (scaleAnimated)
+        {
+            track.animatedChannels |= TrackScale;
+            track.scaleIndex = clip.animatedScaleCount++;
+        }
+        else
+        {
+            track.scaleIndex = clip.constantScales.size();
+            clip.constantScales.push_back(first.scale);
+        }
+    }
+
+    // Write animated keys frame by frame
+    clip.positionKeys.resize(clip.frameCount * clip.animatedPositionCount);
+    clip.rotationKeys.resize(clip.frameCount * clip.animatedRotationCount);
+    clip.scaleKeys.resize(clip.frameCount * clip.animatedScaleCount);
+
+    for (int frame = 0; frame < clip.frameCount; frame++)
+    {
+        for (int bone = 0; bone < boneCount; bone++)
+        {
+            const BoneTrack& track = clip.boneTracks[bone];
+            const Transform& transform = frames[frame].boneTransforms[bone];
+
+            if (track.animatedChannels & TrackPosition)
+            {
+                clip.positionKeys[frame * clip.animatedPositionCount + track.positionIndex] = transform.position;
+            }
+
+            if (track.animatedChannels & TrackRotation)
+            {
+                clip.rotationKeys[frame * clip.animatedRotationCount + track.rotationIndex] = CompressQuaternion(transform.rotation);
+            }
+
+            if (track.animatedChannels & TrackScale)
+            {
+                clip.scaleKeys[frame * clip.animatedScaleCount + track.scaleIndex] = transform.scale;
+            }
+        }
+    }
+
+    return clip;
+}
+
+void SampleAnimationClip(const AnimationClip& clip, float time, Pose& outPose)
+{
+    SampleAnimationClip(clip.GetView(), time, outPose);
+}
+
+// Decodes bones[0..count), or every bone when bones is null
+static void SampleBones(const AnimationClipView& clip, float time, const int* bones, int count, Transform* outTransforms)
+{
+    int boneCount = clip.boneCount;
+    if (clip.frameCount == 0)
+    {
+        return;
+    }
+
+    // Uniform sampling: the key pair is found by arithmetic, no search
+    float framePosition = Clamp(time, 0.0f, clip.duration) * clip.sampleRate;
+    int frame0 = (int)framePosition;
+    if (frame0 > clip.frameCount - 1)
+    {
+        frame0 = clip.frameCount - 1;
+    }
+
+    int frame1 = frame0 + 1 < clip.frameCount ? frame0 + 1 : frame0;
+    float alpha = Clamp(framePosition - frame0, 0.0f, 1.0f);
+
+    const Vector3* positions0 = clip.positionKeys + frame0 * clip.animatedPositionCount;
+    const Vector3* positions1 = clip.positionKeys + frame1 * clip.animatedPositionCount;
+    const CompressedQuaternion* rotations0 = clip.rotationKeys + frame0 * clip.animatedRotationCount;
+    const CompressedQuaternion* rotations1 = clip.rotationKeys + frame1 * clip.animatedRotationCount;
+    const Vector3* scales0 = clip.scaleKeys + frame0 * clip.animatedScaleCount;
+    const Vector3* scales1 = clip.scaleKeys + frame1 * clip.animatedScaleCount;
+
+    for (int i = 0; i < count; i++)
+    {
+        int bone = bones != nullptr ? bones[i] : i;
+        if (bone < 0 || bone >= boneCount)
+        {
+            continue;
+        }
+
+        const BoneTrack& track = clip.boneTracks[bone];
+        Transform& transform = outTransforms[bone];
+
+        if (track.animatedChannels & TrackPosition)
+        {
+            transform.position = Lerp(positions0[track.positionIndex], positions1[track.positionIndex], alpha);
+        }
+        else
+        {
+            transform.position = clip.constantPositions[track.positionIndex];
+        }
+
+        if (track.animatedChannels & TrackRotation)
+        {
+            transform.rotation = Nlerp(DecompressQuaternion(rotations0[track.rotationIndex]), DecompressQuaternion(rotations1[track.rotationIndex]), alpha);
+        }
+        else
+        {
+            transform.rotation = DecompressQuaternion(clip.constantRotations[track.rotationIndex]);
+        }
+
+        if (track.animatedChannels & TrackScale)
+        {
+            transform.scale = Lerp(scales0[track.scaleIndex], scales1[track.scaleIndex], alpha);
+        }
+        else
+        {
+            transform.scale = clip.constantScales[track.scaleIndex];
+        }
+    }
+}
+
+void SampleAnimationClip(const AnimationClipView& clip, float time, Pose& outPose)
+{
+    outPose.boneTransforms.resize(clip.boneCount);
+    SampleBones(clip, time, nullptr, clip.boneCount, outPose.boneTransforms.data());
+}
+
+void SampleAnimationClip(const AnimationClip& clip, float time, const int* bones, int count, Pose& outPose)
+{
+    SampleAnimationClip(clip.GetView(), time, bones, count, outPose);
+}
+
+void SampleAnimationClip(const AnimationClipView& clip, float time, const int* bones, int count, Pose& outPose)
+{
+    outPose.boneTransforms.resize(clip.boneCount);
+    SampleBones(clip, time, bones, count, outPose.boneTransforms.data());
+}
+
+void SampleAnimationClip(const AnimationClip& clip, float time, const int* bones, int count, Transform* outTransforms)
+{
+    SampleAnimationClip(clip.GetView(), time, bones, count, outTransforms);
+}
+
+void SampleAnimationClip(const AnimationClipView& clip, float time, const int* bones, int count, Transform* outTransforms)
+{
+    SampleBones(clip, time, bones, bones != nullptr ? count : clip.boneCount, outTransforms);
+}
+
+RootMotion GetRootMotion(const AnimationClip& clip, float startTime, float endTime)
+{
+    return GetRootMotion(clip.GetView(), startTime, endTime);
+}
+
+// Motion since frame 0 at a time within the clip
+static RootMotion SampleRootMotion(const AnimationClipView& clip, float time)
+{
+    float framePosition = Clamp(time, 0.0f, clip.duration) * clip.sampleRate;
+    int frame0 = std::min((int)framePosition, clip.frameCount - 1);
+    int frame1 = std::min(frame0 + 1, clip.frameCount - 1);
+    float alpha = Clamp(framePosition - frame0, 0.0f, 1.0f);
+
+    const RootMotion& key0 = clip.rootMotionKeys[frame0];
+    const RootMotion& key1 = clip.rootMotionKeys[frame1];
+    return RootMotion(Lerp(key0.translation, key1.translation, alpha), Lerp(key0.yaw, key1.yaw, alpha));
+}
+
+// motion composed count times, by repeated squaring
+static RootMotion RepeatRootMotion(const RootMotion& motion, long long count)
+{
+    RootMotion result;
+    RootMotion power = motion;
+
+    for (; count > 0; count >>= 1)
+    {
+        if (count & 1)
+        {
+            result = Combine(result, power);
+        }
+        power = Combine(power, power);
+    }
+
+    return result;
+}
+
+RootMotion GetRootMotion(const AnimationClipView& clip, float startTime, float endTime)
+{
+    if (clip.rootMotionKeys == nullptr || clip.frameCount == 0 || clip.duration <= 0.0f)
+    {
+        return RootMotion();
+    }
+
+    if (endTime < startTime)
+    {
+        return Inverse(GetRootMotion(clip, endTime, startTime));
+    }
+
+    float startCycle = std::floor(startTime / clip.duration);
+    float endCycle = std::floor(endTime / clip.duration);
+
+    // Back to the start of the first cycle, then forward through every cycle boundary crossed
+    RootMotion result = Inverse(SampleRootMotion(clip, startTime - startCycle * clip.duration));
+    long long crossedCycles = (long long)endCycle - (long long)startCycle;
+    result = Combine(result, RepeatRootMotion(clip.rootMotionKeys[clip.frameCount - 1], crossedCycles));
+
+    return Combine(result, SampleRootMotion(clip, endTime - endCycle * clip.duration));
+}
@@ -0,0 +1,449 @@
+#include "../Headers/AnimationFile.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(Vector3) == 12, "Vector3 layout is part of the animation file format");
+static_assert(sizeof(Transform) == 40, "Transform layout is part of the animation file format");
+static_assert(sizeof(CompressedQuaternion) == 6, "CompressedQuaternion layout is part of the animation file format");
+static_assert(sizeof(BoneTrack) == 8, "BoneTrack layout is part of the animation file format");
+static_assert(sizeof(RootMotion) == 16, "RootMotion layout is part of the animation file format");
+
+static const uint32_t SectionAlignment = 16;
+
+// Append raw bytes at the next aligned position and return their offset
+static uint32_t AppendSection(std::vector<unsigned char>& buffer, const void* bytes, size_t byteCount)
+{
+    size_t offset = (buffer.size() + SectionAlignment - 1) & ~(size_t)(SectionAlignment - 1);
+    buffer.resize(offset + byteCount);
+
+    if (byteCount > 0)
+    {
+        std::memcpy(&buffer[offset], bytes, byteCount);
+    }
+
+    return (uint32_t)offset;
+}
+
+// Uniform sampling needs a positive rate; only a clip of at most one frame may last zero seconds
+static bool IsValidTiming(float sampleRate, float duration, uint32_t frameCount)
+{
+    return std::isfinite(sampleRate) && sampleRate > 0.0f && std::isfinite(duration) && (duration > 0.0f || (duration == 0.0f && frameCount <= 1));
+}
+
+// Whether a track's index fits the constant or animated stream its channel flag selects
+static bool IsValidTrackIndex(const BoneTrack& track, uint8_t channel, uint16_t index, uint32_t constantCount, uint32_t animatedCount)
+{
+    return index < ((track.animatedChannels & channel) ? animatedCount : constantCount);
+}
+
+static uint32_t AppendString(std::vector<char>& stringTable, const std::string& value)
+{
+    uint32_t offset = stringTable.size();
+    stringTable.insert(stringTable.end(), value.begin(), value.end());
+    stringTable.push_back('\0');
+    return offset;
+}
+
+bool WriteAnimationFile(const std::string& path, const Skeleton& skeleton, const std::vector<AnimationClip>& clips)
+{
+    std::vector<unsigned char> buffer(sizeof(AnimationFileHeader));
+    std::vector<char> stringTable;
+
+    AnimationFileHeader header = AnimationFileHeader();
+    header.magic = AnimationFileMagic;
+    header.version = AnimationFileVersion;
+    header.boneCount = skeleton.GetBoneCount();
+    header.clipCount = clips.size();
+
+    // Skeleton
+    std::vector<int32_t> parentIndices(header.boneCount);
+    std::vector<uint32_t> nameOffsets(header.boneCount);
+    std::vector<Transform> bindPose(header.boneCount);
+
+    for (int i = 0; i < header.boneCount; i++)
+    {
+        // Parents come first in the file; the parents Skeleton treats as roots are stored as -1
+        int parent = skeleton.GetParentIndex(i);
+        if (parent > i && parent < header.boneCount)
+        {
+            return false;
+        }
+
+        parentIndices[i] = i == 0 || parent < 0 || parent >= i ? -1 : parent;
+        nameOffsets[i] = AppendString(stringTable, skeleton.GetBoneName(i));
+        bindPose[i] = skeleton.GetLocalPose(i);
+    }
+
+    header.parentIndicesOffset = AppendSection(buffer, parentIndices.data(), parentIndices.size() * sizeof(int32_t));
+    header.boneNamesOffset = AppendSection(buffer, nameOffsets.data(), nameOffsets.size() * sizeof(uint32_t));
+    header.bindPoseOffset = AppendSection(buffer, bindPose.data(), bindPose.size() * sizeof(Transform));
+
+    // Clips: reserve the table first, then append each clip's streams and patch its entry
+    std::vector<AnimationFileClip> clipTable(clips.size());
+    header.clipTableOffset = AppendSection(buffer, clipTable.data(), clipTable.size() * sizeof(AnimationFileClip));
+
+    for (int i = 0; i < clips.size(); i++)
+    {
+        const AnimationClip& clip = clips[i];
+        AnimationFileClip& entry = clipTable[i];
+
+        if (clip.GetBoneCount() != header.boneCount || !IsValidTiming(clip.sampleRate, clip.duration, clip.frameCount))
+        {
+            return false;
+        }
+
+        entry.nameOffset = AppendString(stringTable, clip.name);
+        entry.duration = clip.duration;
+        entry.sampleRate = clip.sampleRate;
+        entry.frameCount = clip.frameCount;
+        entry.animatedPositionCount = clip.animatedPositionCount;
+        entry.animatedRotationCount = clip.animatedRotationCount;
+        entry.animatedScaleCount = clip.animatedScaleCount;
+        entry.constantPositionCount = clip.constantPositions.size();
+        entry.constantRotationCount = clip.constantRotations.size();
+        entry.constantScaleCount = clip.constantScales.size();
+        entry.rootMotionKeyCount = clip.rootMotionKeys.size();
+
+        entry.boneTracksOffset = AppendSection(buffer, clip.boneTracks.data(), clip.boneTracks.size() * sizeof(BoneTrack));
+        entry.constantPositionsOffset = AppendSection(buffer, clip.constantPositions.data(), clip.constantPositions.size() * sizeof(Vector3));
+        entry.constantRotationsOffset = AppendSection(buffer, clip.constantRotations.data(), clip.constantRotations.size() * sizeof(CompressedQuaternion));
+        entry.constantScalesOffset = AppendSection(buffer, clip.constantScales.data(), clip.constantScales.size() * sizeof(Vector3));
+        entry.positionKeysOffset = AppendSection(buffer, clip.positionKeys.data(), clip.positionKeys.size() * sizeof(Vector3));
+        entry.rotationKeysOffset = AppendSection(buffer, clip.rotationKeys.data(), clip.rotationKeys.size() * sizeof(CompressedQuaternion));
+        entry.scaleKeysOffset = AppendSection(buffer, clip.scaleKeys.data(), clip.scaleKeys.size() * sizeof(Vector3));
+        entry.rootMotionKeysOffset = AppendSection(buffer, clip.rootMotionKeys.data(), clip.rootMotionKeys.size() * sizeof(RootMotion));
+    }
+
+    if (!clipTable.empty())
+    {
+        std::memcpy(&buffer[header.clipTableOffset], clipTable.data(), clipTable.size() * sizeof(AnimationFileClip));
+    }
+
+    header.stringTableOffset = AppendSection(buffer, stringTable.data(), stringTable.size());
+    header.stringTableSize = stringTable.size();
+    header.fileSize = buffer.size();
+    std::memcpy(&buffer[0], &header, sizeof(AnimationFileHeader));
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    bool written = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    return std::fclose(file) == 0 && written;
+}
+
+void BuildSkeleton(const SkeletonView& view, Skeleton& outSkeleton)
+{
+    outSkeleton = Skeleton();
+
+    for (int i = 0; i < view.boneCount; i++)
+    {
+        outSkeleton.AddBone(view.GetBoneName(i), view.parentIndices[i], view.bindPose[i]);
+    }
+}
+
+const char* SkeletonView::GetBoneName(int boneIndex) const
+{
+    if (boneIndex < 0 || boneIndex >= boneCount)
+    {
+        return "";
+    }
+
+    return stringTable + nameOffsets[boneIndex];
+}
+
+AnimationFile::AnimationFile() : data(nullptr), size(0), fileHandle(nullptr), mappingHandle(nullptr)
+{
+
+}
+
+AnimationFile::~AnimationFile()
+{
+    Close();
+}
+
+bool AnimationFile::Open(const std::string& path)
+{
+    Close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    size = (size_t)fileSize.QuadPart;
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+
+    if (mapped == MAP_FAILED)
+    {
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(mapped);
+    size = fileStat.st_size;
+#endif
+
+    if (data == nullptr || !Validate())
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void AnimationFile::Close()
+{
+#if defined(_WIN32)
+    if (data != nullptr)
+    {
+        UnmapViewOfFile(data);
+    }
+
+    if (mappingHandle != nullptr)
+    {
+        CloseHandle(mappingHandle);
+    }
+
+    if (fileHandle != nullptr)
+    {
+        CloseHandle(fileHandle);
+    }
+#else
+    if (data != nullptr)
+    {
+        munmap(const_cast<unsigned char*>(data), size);
+    }
+#endif
+
+    data = nullptr;
+    size = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
+
+bool AnimationFile::IsOpen() const
+{
+    return data != nullptr;
+}
+
+// Bounds-check every section once at open so sampling can trust the offsets
+bool AnimationFile::Validate() const
+{
+    if (size < sizeof(AnimationFileHeader))
+    {
+        return false;
+    }
+
+    const AnimationFileHeader* header = reinterpret_cast<const AnimationFileHeader*>(data);
+    if (header->magic != AnimationFileMagic || header->version != AnimationFileVersion || header->fileSize != size)
+    {
+        return false;
+    }
+
+    auto fits = [this](uint32_t offset, uint64_t count, size_t elementSize)
+    {
+        return offset % SectionAlignment == 0 && offset + count * elementSize <= size;
+    };
+
+    if (!fits(header->parentIndicesOffset, header->boneCount, sizeof(int32_t))
+        || !fits(header->boneNamesOffset, header->boneCount, sizeof(uint32_t))
+        || !fits(header->bindPoseOffset, header->boneCount, sizeof(Transform))
+        || !fits(header->clipTableOffset, header->clipCount, sizeof(AnimationFileClip))
+        || !fits(header->stringTableOffset, header->stringTableSize, 1))
+    {
+        return false;
+    }
+
+    // Names must point inside the string table, which must end with a terminator
+    const char* strings = reinterpret_cast<const char*>(data + header->stringTableOffset);
+    if (header->stringTableSize > 0 && strings[header->stringTableSize - 1] != '\0')
+    {
+        return false;
+    }
+
+    // Parents before children, so building the skeleton and propagating poses never reads past a bone
+    const uint32_t* nameOffsets = reinterpret_cast<const uint32_t*>(data + header->boneNamesOffset);
+    const int32_t* parentIndices = reinterpret_cast<const int32_t*>(data + header->parentIndicesOffset);
+    for (uint32_t i = 0; i < header->boneCount; i++)
+    {
+        if (nameOffsets[i] >= header->stringTableSize || parentIndices[i] < -1 || parentIndices[i] >= (int64_t)i)
+        {
+            return false;
+        }
+    }
+
+    const AnimationFileClip* clips = reinterpret_cast<const AnimationFileClip*>(data + header->clipTableOffset);
+    for (uint32_t i = 0; i < header->clipCount; i++)
+    {
+        const AnimationFileClip& clip = clips[i];
+
+        if (clip.nameOffset >= header->stringTableSize
+            || !fits(clip.boneTracksOffset, header->boneCount, sizeof(BoneTrack))
+            || !fits(clip.constantPositionsOffset, clip.constantPositionCount, sizeof(Vector3))
+            || !fits(clip.constantRotationsOffset, clip.constantRotationCount, sizeof(CompressedQuaternion))
+            || !fits(clip.constantScalesOffset, clip.constantScaleCount, sizeof(Vector3))
+            || !fits(clip.positionKeysOffset, (uint64_t)clip.frameCount * clip.animatedPositionCount, sizeof(Vector3))
+            || !fits(clip.rotationKeysOffset, (uint64_t)clip.frameCount * clip.animatedRotationCount, sizeof(CompressedQuaternion))
+            || !fits(clip.scaleKeysOffset, (uint64_t)clip.frameCount * clip.animatedScaleCount, sizeof(Vector3))
+            || (clip.rootMotionKeyCount != 0 && clip.rootMotionKeyCount != clip.frameCount)
+            || !fits(clip.rootMotionKeysOffset, clip.rootMotionKeyCount, sizeof(RootMotion))
+            || !IsValidTiming(clip.sampleRate, clip.duration, clip.frameCount))
+        {
+            return false;
+        }
+
+        // Sampling indexes the channel streams through the tracks without further checks
+        const BoneTrack* tracks = reinterpret_cast<const BoneTrack*>(data + clip.boneTracksOffset);
+        for (uint32_t bone = 0; bone < header->boneCount; bone++)
+        {
+            const BoneTrack& track = tracks[bone];
+            if (!IsValidTrackIndex(track, TrackPosition, track.positionIndex, clip.constantPositionCount, clip.animatedPositionCount)
+                || !IsValidTrackIndex(track, TrackRotation, track.rotationIndex, clip.constantRotationCount, clip.animatedRotationCount)
+                || !IsValidTrackIndex(track, TrackScale, track.scaleIndex, clip.constantScaleCount, clip.animatedScaleCount))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+SkeletonView AnimationFile::GetSkeleton() const
+{
+    SkeletonView view;
+
+    if (!IsOpen())
+    {
+        return view;
+    }
+
+    const AnimationFileHeader* header = reinterpret_cast<const AnimationFileHeader*>(data);
+
+    view.boneCount = header->boneCount;
+    view.parentIndices = reinterpret_cast<const int32_t*>(data + header->parentIndicesOffset);
+    view.nameOffsets = reinterpret_cast<const uint32_t*>(data + header->boneNamesOffset);
+    view.bindPose = reinterpret_cast<const Transform*>(data + header->bindPoseOffset);
+    view.stringTable = reinterpret_cast<const char*>(data + header->stringTableOffset);
+
+    return view;
+}
+
+int AnimationFile::GetClipCount() const
+{
+    if (!IsOpen())
+    {
+        return 0;
+    }
+
+    return reinterpret_cast<const AnimationFileHeader*>(data)->clipCount;
+}
+
+const char* AnimationFile::GetClipName(int clipIndex) const
+{
+    if (clipIndex < 0 || clipIndex >= GetClipCount())
+    {
+        return "";
+    }
+
+    const AnimationFileHeader* header = reinterpret_cast<const AnimationFileHeader*>(data);
+    const AnimationFileClip* clips = reinterpret_cast<const AnimationFileClip*>(data + header->clipTableOffset);
+
+    return reinterpret_cast<const char*>(data + header->stringTableOffset) + clips[clipIndex].nameOffset;
+}
+
+int AnimationFile::FindClip(const std::string& name) const
+{
+    for (int i = 0; i < GetClipCount(); i++)
+    {
+        if (name == GetClipName(i))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+AnimationClipView AnimationFile::GetClip(int clipIndex) const
+{
+    AnimationClipView view;
+
+    if (clipIndex < 0 || clipIndex >= GetClipCount())
+    {
+        return view;
+    }
+
+    const AnimationFileHeader* header = reinterpret_cast<const AnimationFileHeader*>(data);
+    const AnimationFileClip& clip = reinterpret_cast<const AnimationFileClip*>(data + header->clipTableOffset)[clipIndex];
+
+    view.duration = clip.duration;
+    view.sampleRate = clip.sampleRate;
+    view.frameCount = clip.frameCount;
+    view.boneCount = header->boneCount;
+
+    view.animatedPositionCount = clip.animatedPositionCount;
+    view.animatedRotationCount = clip.animatedRotationCount;
+    view.animatedScaleCount = clip.animatedScaleCount;
+
+    view.boneTracks = reinterpret_cast<const BoneTrack*>(data + clip.boneTracksOffset);
+    view.constantPositions = reinterpret_cast<const Vector3*>(data + clip.constantPositionsOffset);
+    view.constantRotations = reinterpret_cast<const CompressedQuaternion*>(data + clip.constantRotationsOffset);
+    view.constantScales = reinterpret_cast<const Vector3*>(data + clip.constantScalesOffset);
+    view.positionKeys = reinterpret_cast<const Vector3*>(data + clip.positionKeysOffset);
+    view.rotationKeys = reinterpret_cast<const CompressedQuaternion*>(data + clip.rotationKeysOffset);
+    view.scaleKeys = reinterpret_cast<const Vector3*>(data + clip.scaleKeysOffset);
+    view.rootMotionKeys = clip.rootMotionKeyCount > 0 ? reinterpret_cast<const RootMotion*>(data + clip.rootMotionKeysOffset) : nullptr;
+
+    return view;
+}
@@ -0,0 +1,427 @@
+#include "../Headers/AnimationGraph.h"
+#include "../Headers/AnimationProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+int AnimationGraph::AddParameter(const std::string& name)
+{
+    parameterNames.push_back(name);
+    return parameterNames.size() - 1;
+}
+
+int AnimationGraph::FindParameter(const std::string& name) const
+{
+    for (int i = 0; i < parameterNames.size(); i++)
+    {
+        if (parameterNames[i] == name)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+int AnimationGraph::GetParameterCount() const
+{
+    return parameterNames.size();
+}
+
+bool AnimationGraph::IsValidChild(int node) const
+{
+    return node >= 0 && node < nodes.size();
+}
+
+int AnimationGraph::AddNode(AnimationNodeType type, int parameter, int parameterY, std::initializer_list<int> children)
+{
+    for (int child : children)
+    {
+        if (!IsValidChild(child))
+        {
+            return -1;
+        }
+    }
+
+    AnimationNode node = AnimationNode();
+    node.type = type;
+    node.parameter = parameter;
+    node.parameterY = parameterY;
+    node.firstChild = childNodes.size();
+    node.childCount = children.size();
+
+    childNodes.insert(childNodes.end(), children.begin(), children.end());
+    childThresholds.resize(childNodes.size(), 0.0f);
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
+
+int AnimationGraph::AddClip(const AnimationClip* clip)
+{
+    if (clip == nullptr)
+    {
+        return -1;
+    }
+
+    int node = AddNode(ClipNode, -1, -1, {});
+    nodes[node].clip = clip;
+    return node;
+}
+
+int AnimationGraph::AddBlend1D(int parameter, std::initializer_list<BlendChild1D> children)
+{
+    if (parameter < 0 || parameter >= parameterNames.size() || children.size() == 0)
+    {
+        return -1;
+    }
+
+    // Sorted by threshold so weights come from a binary search
+    std::vector<BlendChild1D> sorted(children);
+    std::stable_sort(sorted.begin(), sorted.end(), [](const BlendChild1D& a, const BlendChild1D& b)
+    {
+        return a.threshold < b.threshold;
+    });
+
+    for (const BlendChild1D& child : sorted)
+    {
+        if (!IsValidChild(child.node))
+        {
+            return -1;
+        }
+    }
+
+    int node = AddNode(Blend1DNode, parameter, -1, {});
+    nodes[node].childCount = sorted.size();
+
+    for (const BlendChild1D& child : sorted)
+    {
+        childNodes.push_back(child.node);
+        childThresholds.push_back(child.threshold);
+    }
+
+    return node;
+}
+
+int AnimationGraph::AddBlend2D(int parameterX, int parameterY, const BlendSpace2D* blendSpace, std::initializer_list<int> children)
+{
+    if (blendSpace == nullptr || children.size() != blendSpace->getClipCount()
+        || parameterX < 0 || parameterX >= parameterNames.size() || parameterY < 0 || parameterY >= parameterNames.size())
+    {
+        return -1;
+    }
+
+    int node = AddNode(Blend2DNode, parameterX, parameterY, children);
+    if (node >= 0)
+    {
+        nodes[node].blendSpace = blendSpace;
+    }
+    return node;
+}
+
+int AnimationGraph::AddStateMachine(int stateMachineSlot, std::initializer_list<int> children)
+{
+    if (stateMachineSlot < 0)
+    {
+        return -1;
+    }
+
+    int node = AddNode(StateMachineNode, stateMachineSlot, -1, children);
+    if (node >= 0)
+    {
+        stateMachineSlotCount = std::max(stateMachineSlotCount, stateMachineSlot + 1);
+    }
+    return node;
+}
+
+int AnimationGraph::AddAdditive(int baseNode, int additiveNode, const Pose* referencePose, int weightParameter, const BoneMask* mask)
+{
+    if (referencePose == nullptr || weightParameter < 0 || weightParameter >= parameterNames.size())
+    {
+        return -1;
+    }
+
+    int node = AddNode(AdditiveNode, weightParameter, -1, { baseNode, additiveNode });
+    if (node >= 0)
+    {
+        nodes[node].referencePose = referencePose;
+        nodes[node].mask = mask;
+    }
+    return node;
+}
+
+int AnimationGraph::AddLayer(int baseNode, int layerNode, const BoneMask* mask, int weightParameter)
+{
+    if (mask == nullptr || weightParameter < 0 || weightParameter >= parameterNames.size())
+    {
+        return -1;
+    }
+
+    int node = AddNode(LayerNode, weightParameter, -1, { baseNode, layerNode });
+    if (node >= 0)
+    {
+        nodes[node].mask = mask;
+    }
+    return node;
+}
+
+void AnimationGraph::SetRoot(int node)
+{
+    root = IsValidChild(node) ? node : -1;
+}
+
+int AnimationGraph::GetNodeCount() const
+{
+    return nodes.size();
+}
+
+void AnimationGraph::InitializeContext(AnimationGraphContext& context) const
+{
+    context.parameters.resize(parameterNames.size(), 0.0f);
+    context.stateMachines.resize(stateMachineSlotCount, nullptr);
+}
+
+static float GetLayerWeight(const AnimationGraphContext& context, int parameter)
+{
+    return std::clamp(context.parameters[parameter], 0.0f, 1.0f);
+}
+
+void AnimationGraph::PropagateWeights(AnimationGraphContext& context) const
+{
+    ANIMATION_PROFILE_SCOPE(ProfileBlendWeights);
+    context.nodeWeights.assign(nodes.size(), 0.0f);
+    context.childWeights.assign(childNodes.size(), 0.0f);
+    context.nodeWeights[root] = 1.0f;
+
+    // Children always have lower indices than their parents, so one descending pass is top-down
+    for (int n = root; n >= 0; n--)
+    {
+        float weight = context.nodeWeights[n];
+        if (weight < context.weightThreshold)
+        {
+            continue;
+        }
+
+        const AnimationNode& node = nodes[n];
+        BlendSample samples[3];
+        int sampleCount = 0;
+
+        switch (node.type)
+        {
+        case ClipNode:
+            break;
+        case Blend1DNode:
+        {
+            BlendWeights1D weights = CalculateBlendWeights1D(&childThresholds[node.firstChild], node.childCount, context.parameters[node.parameter]);
+            std::copy(weights.samples, weights.samples + weights.count, samples);
+            sampleCount = weights.count;
+            break;
+        }
+        case Blend2DNode:
+        {
+            BlendWeights2D weights = node.blendSpace->calculateWeights(context.parameters[node.parameter], context.parameters[node.parameterY]);
+            std::copy(weights.samples, weights.samples + weights.count, samples);
+            sampleCount = weights.count;
+            break;
+        }
+        case StateMachineNode:
+        {
+            const StateMachineInstance* instance = context.stateMachines[node.parameter];
+            if (instance == nullptr || instance->currentState < 0 || instance->currentState >= node.childCount)
+            {
+                break;
+            }
+
+            float transitionWeight = instance->getTransitionWeight();
+            samples[sampleCount++] = { instance->currentState, transitionWeight };
+            if (instance->isTransitioning() && instance->previousState < node.childCount)
+            {
+                samples[sampleCount++] = { instance->previousState, 1.0f - transitionWeight };
+            }
+            break;
+        }
+        case AdditiveNode:
+        case LayerNode:
+            samples[sampleCount++] = { 0, 1.0f };
+            samples[sampleCount++] = { 1, GetLayerWeight(context, node.parameter) };
+            break;
+        }
+
+        for (int i = 0; i < sampleCount; i++)
+        {
+            float childWeight = weight * samples[i].weight;
+            if (childWeight < context.weightThreshold)
+            {
+                continue;
+            }
+
+            int edge = node.firstChild + samples[i].clipIndex;
+            context.childWeights[edge] = childWeight;
+            context.nodeWeights[childNodes[edge]] += childWeight;
+        }
+    }
+}
+
+static Pose* AcquirePose(AnimationGraphContext& context)
+{
+    if (context.freePoses.empty())
+    {
+        context.posePool.emplace_back();
+        return &context.posePool.back();
+    }
+
+    Pose* pose = context.freePoses.back();
+    context.freePoses.pop_back();
+    return pose;
+}
+
+static void ReleasePose(AnimationGraphContext& context, Pose* pose)
+{
+    context.freePoses.push_back(pose);
+}
+
+// rootMotionWeight is the node's share of the final pose, renormalized over the children that survived pruning
+bool AnimationGraph::EvaluateNode(AnimationGraphContext& context, int n, float rootMotionWeight, Pose& outPose) const
+{
+    const AnimationNode& node = nodes[n];
+
+    if (node.type == ClipNode)
+    {
+        ANIMATION_PROFILE_SCOPE(ProfileSampling);
+        ANIMATION_PROFILE_COUNT(CounterClipsSampled, 1);
+
+        float clipTime = node.clip->duration > 0.0f ? std::fmod(context.time, node.clip->duration) : 0.0f;
+        if (context.bones != nullptr)
+        {
+            SampleAnimationClip(*node.clip, clipTime, context.bones, context.boneCount, outPose);
+        }
+        else
+        {
+            SampleAnimationClip(*node.clip, clipTime, outPose);
+        }
+        context.sampledClipCount++;
+
+        if (rootMotionWeight > 0.0f && !node.clip->rootMotionKeys.empty())
+        {
+            RootMotion motion = GetRootMotion(*node.clip, context.time - context.deltaTime, context.time);
+            context.rootMotion = context.rootMotion + motion * rootMotionWeight;
+        }
+        return true;
+    }
+
+    if (node.type == AdditiveNode || node.type == LayerNode)
+    {
+        if (!EvaluateNode(context, childNodes[node.firstChild], rootMotionWeight, outPose))
+        {
+            return false;
+        }
+
+        if (context.childWeights[node.firstChild + 1] > 0.0f)
+        {
+            Pose* layer = AcquirePose(context);
+            if (EvaluateNode(context, childNodes[node.firstChild + 1], 0.0f, *layer))
+            {
+                float weight = GetLayerWeight(context, node.parameter);
+                if (node.type == LayerNode)
+                {
+                    BlendPoseLayer(outPose, *layer, weight, *node.mask);
+                }
+                else if (node.mask != nullptr)
+                {
+                    ApplyAdditivePose(outPose, *layer, *node.referencePose, weight, *node.mask, outPose);
+                }
+                else
+                {
+                    ApplyAdditivePose(outPose, *layer, *node.referencePose, weight, outPose);
+                }
+            }
+            ReleasePose(context, layer);
+        }
+        return true;
+    }
+
+    int activeChildren = 0;
+    int lastActive = -1;
+    float activeWeight = 0.0f;
+    for (int edge = node.firstChild; edge < node.firstChild + node.childCount; edge++)
+    {
+        if (context.childWeights[edge] > 0.0f)
+        {
+            activeChildren++;
+            lastActive = edge;
+            activeWeight += context.childWeights[edge];
+        }
+    }
+
+    if (activeChildren == 0)
+    {
+        return false;
+    }
+
+    // A single surviving child needs no blend
+    if (activeChildren == 1)
+    {
+        return EvaluateNode(context, childNodes[lastActive], rootMotionWeight, outPose);
+    }
+
+    // Child poses go on a stack shared by the whole recursion, so nested blends allocate nothing once warm
+    int stackBase = context.blendPoses.size();
+
+    for (int edge = node.firstChild; edge < node.firstChild + node.childCount; edge++)
+    {
+        if (context.childWeights[edge] <= 0.0f)
+        {
+            continue;
+        }
+
+        Pose* childPose = AcquirePose(context);
+        if (EvaluateNode(context, childNodes[edge], rootMotionWeight * context.childWeights[edge] / activeWeight, *childPose))
+        {
+            context.blendPoses.push_back(childPose);
+            context.blendWeights.push_back(context.childWeights[edge]);
+        }
+        else
+        {
+            ReleasePose(context, childPose);
+        }
+    }
+
+    int poseCount = context.blendPoses.size() - stackBase;
+    ANIMATION_PROFILE_COUNT(CounterPosesBlended, poseCount);
+    if (poseCount > 0 && context.bones != nullptr)
+    {
+        ANIMATION_PROFILE_SCOPE(ProfileBlending);
+        BlendPoses(context.blendPoses.data() + stackBase, context.blendWeights.data() + stackBase, poseCount, context.bones, context.boneCount, outPose);
+        context.blendedPoseCount += poseCount;
+    }
+    else if (poseCount > 0)
+    {
+        ANIMATION_PROFILE_SCOPE(ProfileBlending);
+        BlendPoses(context.blendPoses.data() + stackBase, context.blendWeights.data() + stackBase, poseCount, outPose);
+        context.blendedPoseCount += poseCount;
+    }
+
+    for (int i = stackBase; i < context.blendPoses.size(); i++)
+    {
+        ReleasePose(context, context.blendPoses[i]);
+    }
+    context.blendPoses.resize(stackBase);
+    context.blendWeights.resize(stackBase);
+
+    return poseCount > 0;
+}
+
+bool AnimationGraph::Evaluate(AnimationGraphContext& context, Pose& outPose) const
+{
+    context.sampledClipCount = 0;
+    context.blendedPoseCount = 0;
+    context.rootMotion = RootMotion();
+
+    if (root < 0)
+    {
+        return false;
+    }
+
+    InitializeContext(context);
+    PropagateWeights(context);
+    return EvaluateNode(context, root, 1.0f, outPose);
+}
@@ -0,0 +1,139 @@
+#include "../Headers/AnimationLOD.h"
+#include "../Headers/AnimationUpdate.h"
+
+#include <algorithm>
+
+// Weight of a new frame in the running cost estimates
+static const float CostSmoothing = 0.1f;
+
+int AnimationLODPolicy::AddLevel(const AnimationLODLevel& level)
+{
+    levels.push_back(level);
+    levels.back().updateInterval = std::max(level.updateInterval, 1);
+    estimatedCosts.push_back(level.costMicroseconds);
+    return levels.size() - 1;
+}
+
+int AnimationLODPolicy::GetLevelCount() const
+{
+    return levels.size();
+}
+
+const AnimationLODLevel& AnimationLODPolicy::GetLevel(int level) const
+{
+    return levels[level];
+}
+
+int AnimationLODPolicy::SelectLevel(float distance) const
+{
+    for (int i = 0; i < levels.size(); i++)
+    {
+        if (distance <= levels[i].maxDistance)
+        {
+            return i;
+        }
+    }
+
+    return levels.size() - 1;
+}
+
+void AnimationLODPolicy::SetLevel(CharacterInstance& character, int level, int index) const
+{
+    int previousInterval = character.lod.updateInterval;
+    character.lodLevel = level;
+    character.lod = levels[level];
+
+    // Spread the full updates of characters switching interval together over the interval's frames
+    if (character.lod.updateInterval != previousInterval)
+    {
+        character.framesSinceUpdate = index % character.lod.updateInterval;
+    }
+}
+
+void AnimationLODPolicy::AssignByDistance(CharacterInstance* characters, int count)
+{
+    if (levels.empty())
+    {
+        return;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        SetLevel(characters[i], SelectLevel(characters[i].lodDistance), i);
+    }
+}
+
+void AnimationLODPolicy::AssignByBudget(CharacterInstance* characters, int count, float budgetMicroseconds)
+{
+    if (levels.empty())
+    {
+        return;
+    }
+
+    order.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        order[i] = i;
+    }
+
+    std::sort(order.begin(), order.end(), [characters](int a, int b)
+    {
+        return characters[a].lodDistance < characters[b].lodDistance;
+    });
+
+    int coarsest = levels.size() - 1;
+    float remaining = budgetMicroseconds;
+
+    for (int k = 0; k < count; k++)
+    {
+        CharacterInstance& character = characters[order[k]];
+
+        // Keep enough budget for every character after this one at the coarsest level
+        float reserved = (count - k - 1) * estimatedCosts[coarsest];
+        int level = SelectLevel(character.lodDistance);
+        while (level < coarsest && estimatedCosts[level] + reserved > remaining)
+        {
+            level++;
+        }
+
+        SetLevel(character, level, order[k]);
+        remaining -= estimatedCosts[level];
+    }
+}
+
+void AnimationLODPolicy::RecordCosts(const CharacterInstance* characters, int count)
+{
+    costSums.assign(levels.size(), 0.0f);
+    costCounts.assign(levels.size(), 0);
+
+    for (int i = 0; i < count; i++)
+    {
+        int level = characters[i].lodLevel;
+        if (level >= 0 && level < levels.size())
+        {
+            costSums[level] += characters[i].lastUpdateMicroseconds;
+            costCounts[level]++;
+        }
+    }
+
+    for (int level = 0; level < levels.size(); level++)
+    {
+        if (costCounts[level] == 0)
+        {
+            continue;
+        }
+
+        float average = costSums[level] / costCounts[level];
+        estimatedCosts[level] = estimatedCosts[level] > 0.0f ? Lerp(estimatedCosts[level], average, CostSmoothing) : average;
+    }
+}
+
+float AnimationLODPolicy::GetEstimatedCost(int level) const
+{
+    if (level < 0 || level >= estimatedCosts.size())
+    {
+        return 0.0f;
+    }
+
+    return estimatedCosts[level];
+}
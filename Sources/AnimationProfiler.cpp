@@ -0,0 +1,289 @@
+#include "../Headers/AnimationProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define ANIMATION_PROFILE_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define ANIMATION_PROFILE_TSC 0
+#endif
+
+static ProfileThreadData profileThreads[MaxProfileThreads];
+static std::atomic<int> profileThreadCount(0);
+static std::atomic<int> profileSampleInterval(32);
+
+static const char* const ProfileStageNames[ProfileStageCount] =
+{
+    "update", "stateMachine", "blendWeights", "sampling", "blending", "hierarchy", "ik"
+};
+
+static const char* const ProfileCounterNames[ProfileCounterCount] =
+{
+    "characters", "clipsSampled", "posesBlended", "bonesProcessed", "ikSolves", "ikIterations", "ikUnreachable"
+};
+
+uint64_t ReadProfileClock()
+{
+#if ANIMATION_PROFILE_TSC
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Both clocks read at startup, so snapshots can convert ticks to nanoseconds over the whole run
+struct ProfileClockOrigin
+{
+    uint64_t ticks;
+    std::chrono::steady_clock::time_point time;
+};
+
+static const ProfileClockOrigin profileClockOrigin = { ReadProfileClock(), std::chrono::steady_clock::now() };
+
+static double GetNanosecondsPerTick()
+{
+#if ANIMATION_PROFILE_TSC
+    uint64_t ticks = ReadProfileClock() - profileClockOrigin.ticks;
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - profileClockOrigin.time).count();
+    return ticks > 0 && nanoseconds > 0.0 ? nanoseconds / ticks : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+ProfileThreadData* RegisterProfileThread()
+{
+    ProfileThreadState& state = profileThreadState;
+    if (!state.registered)
+    {
+        int index = profileThreadCount.fetch_add(1, std::memory_order_relaxed);
+        state.data = index < MaxProfileThreads ? &profileThreads[index] : nullptr;
+        state.registered = true;
+    }
+    return state.data;
+}
+
+static void Add(std::atomic<uint64_t>& value, uint64_t amount)
+{
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+static int GetHistogramBucket(uint64_t ticks)
+{
+    if (ticks == 0)
+    {
+        return 0;
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    int bucket = 63 - __builtin_clzll(ticks);
+#else
+    int bucket = 0;
+    while (ticks >>= 1)
+    {
+        bucket++;
+    }
+#endif
+    return std::min(bucket, ProfileHistogramBuckets - 1);
+}
+
+void SetProfileSampleInterval(int interval)
+{
+    profileSampleInterval.store(std::max(interval, 1), std::memory_order_relaxed);
+}
+
+uint64_t BeginOutermostProfileScope()
+{
+    ProfileThreadState& state = profileThreadState;
+    RegisterProfileThread();
+    int interval = profileSampleInterval.load(std::memory_order_relaxed);
+    state.sampling = state.data != nullptr && state.outermostScopes++ % interval == 0;
+
+    return state.sampling ? ReadProfileClock() | 1 : 0;
+}
+
+void RecordProfileScope(ProfileStage stage, uint64_t start)
+{
+    uint64_t end = ReadProfileClock();
+    uint64_t ticks = end > start ? end - start : 0;
+    ProfileThreadData* data = profileThreadState.data;
+
+    Add(data->calls[stage], 1);
+    Add(data->ticks[stage], ticks);
+    Add(data->histogram[stage][GetHistogramBucket(ticks)], 1);
+    if (ticks > data->maxTicks[stage].load(std::memory_order_relaxed))
+    {
+        data->maxTicks[stage].store(ticks, std::memory_order_relaxed);
+    }
+}
+
+const char* GetProfileStageName(ProfileStage stage)
+{
+    return stage < ProfileStageCount ? ProfileStageNames[stage] : "unknown";
+}
+
+const char* GetProfileCounterName(ProfileCounter counter)
+{
+    return counter < ProfileCounterCount ? ProfileCounterNames[counter] : "unknown";
+}
+
+void TakeProfileSnapshot(ProfileSnapshot& outSnapshot)
+{
+    outSnapshot.nanosecondsPerTick = GetNanosecondsPerTick();
+    outSnapshot.sampleInterval = profileSampleInterval.load(std::memory_order_relaxed);
+    outSnapshot.threads.clear();
+
+    int threadCount = std::min(profileThreadCount.load(std::memory_order_relaxed), MaxProfileThreads);
+    outSnapshot.threads.resize(threadCount);
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        const ProfileThreadData& data = profileThreads[t];
+        ProfileThreadSnapshot& thread = outSnapshot.threads[t];
+        thread.thread = t;
+
+        for (int s = 0; s < ProfileStageCount; s++)
+        {
+            ProfileStageStats& stage = thread.stages[s];
+            stage.calls = data.calls[s].load(std::memory_order_relaxed);
+            stage.totalNanoseconds = data.ticks[s].load(std::memory_order_relaxed) * outSnapshot.nanosecondsPerTick;
+            stage.maxNanoseconds = data.maxTicks[s].load(std::memory_order_relaxed) * outSnapshot.nanosecondsPerTick;
+            for (int b = 0; b < ProfileHistogramBuckets; b++)
+            {
+                stage.histogram[b] = data.histogram[s][b].load(std::memory_order_relaxed);
+            }
+        }
+
+        for (int c = 0; c < ProfileCounterCount; c++)
+        {
+            thread.counters[c] = data.counters[c].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void ResetProfile()
+{
+    int threadCount = std::min(profileThreadCount.load(std::memory_order_relaxed), MaxProfileThreads);
+    for (int t = 0; t < threadCount; t++)
+    {
+        ProfileThreadData& data = profileThreads[t];
+        for (int s = 0; s < ProfileStageCount; s++)
+        {
+            data.calls[s].store(0, std::memory_order_relaxed);
+            data.ticks[s].store(0, std::memory_order_relaxed);
+            data.maxTicks[s].store(0, std::memory_order_relaxed);
+            for (int b = 0; b < ProfileHistogramBuckets; b++)
+            {
+                data.histogram[s][b].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        for (int c = 0; c < ProfileCounterCount; c++)
+        {
+            data.counters[c].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+ProfileStageStats ProfileSnapshot::GetStage(ProfileStage stage) const
+{
+    ProfileStageStats merged;
+    for (const ProfileThreadSnapshot& thread : threads)
+    {
+        const ProfileStageStats& stats = thread.stages[stage];
+        merged.calls += stats.calls;
+        merged.totalNanoseconds += stats.totalNanoseconds;
+        merged.maxNanoseconds = std::max(merged.maxNanoseconds, stats.maxNanoseconds);
+        for (int b = 0; b < ProfileHistogramBuckets; b++)
+        {
+            merged.histogram[b] += stats.histogram[b];
+        }
+    }
+
+    return merged;
+}
+
+uint64_t ProfileSnapshot::GetCounter(ProfileCounter counter) const
+{
+    uint64_t total = 0;
+    for (const ProfileThreadSnapshot& thread : threads)
+    {
+        total += thread.counters[counter];
+    }
+
+    return total;
+}
+
+double ProfileSnapshot::GetBucketNanoseconds(int bucket) const
+{
+    return bucket <= 0 ? 0.0 : (double)(1ull << bucket) * nanosecondsPerTick;
+}
+
+static void ExportStages(const ProfileStageStats* stages, std::ostream& out, const char* indent)
+{
+    out << indent << "\"stages\": {\n";
+    for (int s = 0; s < ProfileStageCount; s++)
+    {
+        const ProfileStageStats& stage = stages[s];
+        out << indent << "  \"" << ProfileStageNames[s] << "\": { \"calls\": " << stage.calls
+            << ", \"totalNanoseconds\": " << stage.totalNanoseconds << ", \"maxNanoseconds\": " << stage.maxNanoseconds << ", \"histogram\": [";
+        for (int b = 0; b < ProfileHistogramBuckets; b++)
+        {
+            out << (b > 0 ? ", " : "") << stage.histogram[b];
+        }
+        out << "] }" << (s + 1 < ProfileStageCount ? "," : "") << "\n";
+    }
+    out << indent << "},\n";
+}
+
+static void ExportCounters(const uint64_t* counters, std::ostream& out, const char* indent)
+{
+    out << indent << "\"counters\": {";
+    for (int c = 0; c < ProfileCounterCount; c++)
+    {
+        out << (c > 0 ? ", " : " ") << "\"" << ProfileCounterNames[c] << "\": " << counters[c];
+    }
+    out << " }\n";
+}
+
+void ExportProfileJson(const ProfileSnapshot& snapshot, std::ostream& out)
+{
+    out << "{\n  \"nanosecondsPerTick\": " << snapshot.nanosecondsPerTick << ",\n  \"sampleInterval\": " << snapshot.sampleInterval
+        << ",\n  \"histogramBucketNanoseconds\": [";
+    for (int b = 0; b < ProfileHistogramBuckets; b++)
+    {
+        out << (b > 0 ? ", " : "") << snapshot.GetBucketNanoseconds(b);
+    }
+    out << "],\n  \"threads\": [\n";
+
+    for (int t = 0; t < snapshot.threads.size(); t++)
+    {
+        const ProfileThreadSnapshot& thread = snapshot.threads[t];
+        out << "    {\n      \"thread\": " << thread.thread << ",\n";
+        ExportStages(thread.stages, out, "      ");
+        ExportCounters(thread.counters, out, "      ");
+        out << "    }" << (t + 1 < snapshot.threads.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n  \"total\": {\n";
+
+    ProfileStageStats stages[ProfileStageCount];
+    uint64_t counters[ProfileCounterCount];
+    for (int s = 0; s < ProfileStageCount; s++)
+    {
+        stages[s] = snapshot.GetStage((ProfileStage)s);
+    }
+    for (int c = 0; c < ProfileCounterCount; c++)
+    {
+        counters[c] = snapshot.GetCounter((ProfileCounter)c);
+    }
+    ExportStages(stages, out, "    ");
+    ExportCounters(counters, out, "    ");
+    out << "  }\n}\n";
+}
@@ -0,0 +1,509 @@
+#include "../Headers/AnimationUpdate.h"
+#include "../Headers/AnimationProfiler.h"
+#include "../Headers/FrameArena.h"
+
+#include <algorithm>
+#include <chrono>
+
+// Roots match the skeleton's update order: bone 0 and bones without a valid parent
+static int GetBoneDepth(const Skeleton& skeleton, int bone)
+{
+    int boneCount = skeleton.GetBoneCount();
+    int depth = 0;
+
+    while (bone != 0 && depth < boneCount)
+    {
+        int parent = skeleton.GetParentIndex(bone);
+        if (parent < 0 || parent >= boneCount || parent == bone)
+        {
+            break;
+        }
+
+        bone = parent;
+        depth++;
+    }
+
+    return depth;
+}
+
+// Null when every bone is kept
+static const std::vector<int>* GetActiveBones(CharacterInstance& character)
+{
+    if (character.skeleton == nullptr || (character.lod.maxBoneDepth < 0 && character.requiredBones.empty()))
+    {
+        return nullptr;
+    }
+
+    Skeleton& skeleton = *character.skeleton;
+    if (character.lodBonesDirty || character.lodBonesDepth != character.lod.maxBoneDepth)
+    {
+        int maxDepth = character.lod.maxBoneDepth;
+        character.lodBones.clear();
+
+        if (!character.requiredBones.empty())
+        {
+            // Cutting an ancestor-closed, parent-first list by depth keeps it both
+            for (int bone : character.requiredBones)
+            {
+                if (maxDepth < 0 || GetBoneDepth(skeleton, bone) <= maxDepth)
+                {
+                    character.lodBones.push_back(bone);
+                }
+            }
+        }
+        else
+        {
+            for (int depth = 0; depth <= maxDepth; depth++)
+            {
+                for (int bone = 0; bone < skeleton.GetBoneCount(); bone++)
+                {
+                    if (GetBoneDepth(skeleton, bone) == depth)
+                    {
+                        character.lodBones.push_back(bone);
+                    }
+                }
+            }
+        }
+
+        character.lodBonesDepth = maxDepth;
+        character.lodBonesDirty = false;
+
+        // Brings the skipped bones up to date once; in headless mode only the required bones are propagated from now on.
+        // Bones joining the subset were not sampled lately, so the next update evaluates instead of interpolating.
+        skeleton.UpdateWorldPoses();
+        character.lodTargetPose.boneTransforms.clear();
+    }
+
+    return &character.lodBones;
+}
+
+void SetRequiredBones(CharacterInstance& character, const int* bones, int count)
+{
+    character.requiredBones.clear();
+    if (character.skeleton != nullptr && count > 0)
+    {
+        character.skeleton->GetRequiredBones(bones, count, character.requiredBones);
+    }
+    character.lodBonesDirty = true;
+}
+
+static void SamplePose(CharacterInstance& character, const AnimationClip& clip, float time, Transform* outTransforms)
+{
+    ANIMATION_PROFILE_SCOPE(ProfileSampling);
+    ANIMATION_PROFILE_COUNT(CounterClipsSampled, 1);
+
+    const std::vector<int>* bones = GetActiveBones(character);
+    SampleAnimationClip(clip, time, bones != nullptr ? bones->data() : nullptr, bones != nullptr ? bones->size() : 0, outTransforms);
+}
+
+static void BlendPose(CharacterInstance& character, const Transform* const* poses, const float* weights, int poseCount, int boneCount, Transform* outTransforms)
+{
+    ANIMATION_PROFILE_SCOPE(ProfileBlending);
+    ANIMATION_PROFILE_COUNT(CounterPosesBlended, poseCount);
+
+    const std::vector<int>* bones = GetActiveBones(character);
+    BlendPoses(poses, weights, poseCount, boneCount, bones != nullptr ? bones->data() : nullptr, bones != nullptr ? bones->size() : 0, outTransforms);
+}
+
+// Result of a blend tree or blend space, in the thread's frame arena unless it was blended straight into the destination.
+// Null transforms when no clip had a weight.
+struct EvaluatedPose
+{
+    const Transform* transforms = nullptr;
+    int boneCount = 0;
+    RootMotion rootMotion;
+};
+
+// Samples the clips with a nonzero weight into the frame arena and blends them, into destination when given.
+// A single clip is used as sampled.
+template <typename GetClip>
+static EvaluatedPose BlendClips(CharacterInstance& character, FrameArena& arena, const BlendSample* samples, int sampleCount, GetClip getClip, Pose* destination)
+{
+    EvaluatedPose result;
+    const Transform** poses = arena.Allocate<const Transform*>(sampleCount);
+    float* weights = arena.Allocate<float>(sampleCount);
+    int poseCount = 0;
+    float totalWeight = 0.0f;
+
+    for (int i = 0; i < sampleCount; i++)
+    {
+        const AnimationClip* clip = getClip(samples[i].clipIndex);
+        float weight = samples[i].weight;
+        if (weight <= 0.0f || clip == nullptr)
+        {
+            continue;
+        }
+
+        // Every clip of a blend animates the same rig, the first one sizes the result
+        if (poseCount == 0)
+        {
+            result.boneCount = clip->GetBoneCount();
+        }
+
+        Transform* pose = arena.Allocate<Transform>(clip->GetBoneCount());
+        float clipTime = clip->duration > 0.0f ? std::fmod(character.time, clip->duration) : 0.0f;
+        SamplePose(character, *clip, clipTime, pose);
+
+        poses[poseCount] = pose;
+        weights[poseCount] = weight;
+        poseCount++;
+        totalWeight += weight;
+        character.sampledClipCount++;
+
+        // Root motion is blended with the same weights, over the time window of this evaluation
+        result.rootMotion = result.rootMotion + GetRootMotion(*clip, character.previousTime, character.time) * weight;
+    }
+
+    if (poseCount == 0)
+    {
+        return result;
+    }
+
+    result.rootMotion = result.rootMotion * (1.0f / totalWeight);
+    if (poseCount == 1)
+    {
+        result.transforms = poses[0];
+        return result;
+    }
+
+    Transform* blended = nullptr;
+    if (destination != nullptr)
+    {
+        destination->boneTransforms.resize(result.boneCount);
+        blended = destination->boneTransforms.data();
+    }
+    else
+    {
+        blended = arena.Allocate<Transform>(result.boneCount);
+    }
+
+    BlendPose(character, poses, weights, poseCount, result.boneCount, blended);
+    result.transforms = blended;
+    return result;
+}
+
+// Blend weights, then sampling and blending of the clips with a nonzero weight
+static EvaluatedPose EvaluateBlendTree(CharacterInstance& character, BlendTree1D* blendTree, FrameArena& arena, Pose* destination)
+{
+    if (blendTree == nullptr || blendTree->getClipCount() == 0)
+    {
+        return EvaluatedPose();
+    }
+
+    BlendWeights1D weights;
+    {
+        ANIMATION_PROFILE_SCOPE(ProfileBlendWeights);
+        weights = blendTree->calculateWeights(character.blendParameter);
+    }
+
+    return BlendClips(character, arena, weights.samples, weights.count, [blendTree](int clip) { return blendTree->getClip(clip); }, destination);
+}
+
+// Only the clips of the triangle under the parameter are sampled
+static EvaluatedPose EvaluateBlendSpace(CharacterInstance& character, const BlendSpace2D* blendSpace, FrameArena& arena, Pose* destination)
+{
+    BlendWeights2D weights;
+    {
+        ANIMATION_PROFILE_SCOPE(ProfileBlendWeights);
+        weights = blendSpace->calculateWeights(character.blendParameter, character.blendParameterY);
+    }
+
+    return BlendClips(character, arena, weights.samples, weights.count, [blendSpace](int clip) { return blendSpace->getClip(clip); }, destination);
+}
+
+// Copies an evaluated pose into character.pose, unless it was blended there already; with a bone subset only those bones were evaluated
+static void StorePose(CharacterInstance& character, const EvaluatedPose& evaluated)
+{
+    character.rootMotion = evaluated.rootMotion;
+
+    std::vector<Transform>& pose = character.pose.boneTransforms;
+    if (evaluated.transforms == pose.data() && !pose.empty())
+    {
+        return;
+    }
+
+    pose.resize(evaluated.boneCount);
+    const std::vector<int>* bones = GetActiveBones(character);
+    if (bones == nullptr)
+    {
+        std::copy(evaluated.transforms, evaluated.transforms + evaluated.boneCount, pose.begin());
+        return;
+    }
+
+    for (int bone : *bones)
+    {
+        if (bone < evaluated.boneCount)
+        {
+            pose[bone] = evaluated.transforms[bone];
+        }
+    }
+}
+
+static BlendTree1D* GetStateBlendTree(const CharacterInstance& character, int state)
+{
+    if (state < 0 || state >= (int)character.stateBlendTrees.size())
+    {
+        return nullptr;
+    }
+
+    return character.stateBlendTrees[state];
+}
+
+// State machine, then the current state's pose; the previous state is only evaluated while a cross-fade is active
+static void EvaluatePose(CharacterInstance& character, float deltaTime)
+{
+    if (character.stateMachine != nullptr)
+    {
+        ANIMATION_PROFILE_SCOPE(ProfileStateMachine);
+        character.stateMachine->update(deltaTime);
+    }
+
+    character.previousTime = character.time;
+    character.time += deltaTime;
+    character.rootMotion = RootMotion();
+
+    if (character.graph != nullptr)
+    {
+        AnimationGraphContext& context = character.graphContext;
+        character.graph->InitializeContext(context);
+        if (character.stateMachine != nullptr && !context.stateMachines.empty())
+        {
+            context.stateMachines[0] = &character.stateMachine->getInstance();
+        }
+
+        const std::vector<int>* bones = GetActiveBones(character);
+        context.bones = bones != nullptr ? bones->data() : nullptr;
+        context.boneCount = bones != nullptr ? bones->size() : 0;
+        context.time = character.time;
+        context.deltaTime = deltaTime;
+        character.graph->Evaluate(context, character.pose);
+        character.rootMotion = context.rootMotion;
+        return;
+    }
+
+    // Clip poses and blend lists only live until the pose is stored
+    FrameArena& arena = GetThreadFrameArena();
+    FrameArenaScope arenaScope(arena);
+    character.sampledClipCount = 0;
+
+    if (character.blendSpace != nullptr)
+    {
+        EvaluatedPose evaluated = EvaluateBlendSpace(character, character.blendSpace, arena, &character.pose);
+        if (evaluated.transforms != nullptr)
+        {
+            StorePose(character, evaluated);
+        }
+        return;
+    }
+
+    if (character.stateMachine == nullptr || character.stateBlendTrees.empty())
+    {
+        EvaluatedPose evaluated = EvaluateBlendTree(character, character.blendTree, arena, &character.pose);
+        if (evaluated.transforms != nullptr)
+        {
+            StorePose(character, evaluated);
+        }
+        return;
+    }
+
+    const StateMachineInstance& state = character.stateMachine->getInstance();
+    BlendTree1D* target = GetStateBlendTree(character, state.currentState);
+
+    if (!state.isTransitioning())
+    {
+        EvaluatedPose evaluated = EvaluateBlendTree(character, target, arena, &character.pose);
+        if (evaluated.transforms != nullptr)
+        {
+            StorePose(character, evaluated);
+        }
+        return;
+    }
+
+    EvaluatedPose source = EvaluateBlendTree(character, GetStateBlendTree(character, state.previousState), arena, nullptr);
+    EvaluatedPose targetPose = EvaluateBlendTree(character, target, arena, nullptr);
+
+    if (source.transforms == nullptr || targetPose.transforms == nullptr)
+    {
+        if (source.transforms != nullptr || targetPose.transforms != nullptr)
+        {
+            StorePose(character, targetPose.transforms != nullptr ? targetPose : source);
+        }
+        return;
+    }
+
+    float weight = state.getTransitionWeight();
+    const Transform* poses[2] = { source.transforms, targetPose.transforms };
+    float weights[2] = { 1.0f - weight, weight };
+    character.pose.boneTransforms.resize(source.boneCount);
+    BlendPose(character, poses, weights, 2, source.boneCount, character.pose.boneTransforms.data());
+    character.rootMotion = source.rootMotion * (1.0f - weight) + targetPose.rootMotion * weight;
+}
+
+// Full evaluation on the character's update frames; in between, the last two evaluations are interpolated,
+// so the pose trails the full-rate one by less than one update interval
+static void UpdatePose(CharacterInstance& character, float deltaTime)
+{
+    // A changed bone subset drops the interpolation history, so rebuild it before checking for one
+    GetActiveBones(character);
+
+    int interval = std::max(character.lod.updateInterval, 1);
+    character.pendingDeltaTime += deltaTime;
+    character.rootMotion = RootMotion();
+
+    if (interval == 1)
+    {
+        EvaluatePose(character, character.pendingDeltaTime);
+        character.pendingDeltaTime = 0.0f;
+        character.framesSinceUpdate = 0;
+        character.lodTargetPose.boneTransforms.clear();
+        return;
+    }
+
+    bool hasHistory = !character.lodTargetPose.boneTransforms.empty();
+    if (!hasHistory || character.framesSinceUpdate >= interval)
+    {
+        EvaluatePose(character, character.pendingDeltaTime);
+        character.pendingDeltaTime = 0.0f;
+        character.framesSinceUpdate = 0;
+
+        std::swap(character.lodSourcePose, character.lodTargetPose);
+        character.lodTargetPose.boneTransforms = character.pose.boneTransforms;
+        if (!hasHistory)
+        {
+            character.lodSourcePose.boneTransforms = character.pose.boneTransforms;
+        }
+    }
+
+    character.framesSinceUpdate++;
+    float weight = (float)character.framesSinceUpdate / interval;
+    const Transform* poses[2] = { character.lodSourcePose.boneTransforms.data(), character.lodTargetPose.boneTransforms.data() };
+    float weights[2] = { 1.0f - weight, weight };
+    int boneCount = character.lodSourcePose.boneTransforms.size();
+    character.pose.boneTransforms.resize(boneCount);
+    BlendPose(character, poses, weights, 2, boneCount, character.pose.boneTransforms.data());
+}
+
+static void ApplyPose(CharacterInstance& character)
+{
+    Skeleton& skeleton = *character.skeleton;
+    int boneCount = std::min<int>(skeleton.GetBoneCount(), character.pose.boneTransforms.size());
+
+    const std::vector<int>* bones = GetActiveBones(character);
+    if (bones != nullptr)
+    {
+        for (int bone : *bones)
+        {
+            if (bone < boneCount)
+            {
+                skeleton.SetLocalTransform(bone, character.pose.boneTransforms[bone]);
+            }
+        }
+        return;
+    }
+
+    for (int i = 0; i < boneCount; i++)
+    {
+        skeleton.SetLocalTransform(i, character.pose.boneTransforms[i]);
+    }
+}
+
+// Bones cut by lod.maxBoneDepth keep their last local pose but still follow their parents; only headless mode skips bones here
+static void PropagatePose(CharacterInstance& character)
+{
+    const std::vector<int>& bones = character.requiredBones;
+    if (!bones.empty())
+    {
+        character.skeleton->UpdateWorldPoses(bones.data(), bones.size());
+        ANIMATION_PROFILE_COUNT(CounterBonesProcessed, bones.size());
+        return;
+    }
+
+    character.skeleton->UpdateWorldPoses();
+    ANIMATION_PROFILE_COUNT(CounterBonesProcessed, character.skeleton->GetLastUpdatedBoneCount());
+}
+
+static void SolveIK(CharacterInstance& character)
+{
+    if (!character.useIK || !character.lod.enableIK)
+    {
+        return;
+    }
+
+    ANIMATION_PROFILE_SCOPE(ProfileIK);
+    Vector3 start = character.ikRootBone >= 0 ? character.skeleton->GetWorldPose(character.ikRootBone).position : Vector3();
+    character.ikResult = SolveTwoBoneIK(start, character.ikTarget, character.ikChain);
+    ANIMATION_PROFILE_COUNT(CounterIKSolves, 1);
+    ANIMATION_PROFILE_COUNT(CounterIKUnreachable, character.ikResult.isReachable ? 0 : 1);
+}
+
+static float ElapsedMicroseconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Every stage of one character's update; propagate brings the skeleton's world poses up to date after the pose is applied
+template <typename Propagate>
+static void UpdateCharacterStages(CharacterInstance& character, float deltaTime, Propagate propagate)
+{
+    ANIMATION_PROFILE_SCOPE(ProfileUpdate);
+    ANIMATION_PROFILE_COUNT(CounterCharacters, 1);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    UpdatePose(character, deltaTime);
+    character.rootMotionAccumulator.Apply(character.rootMotion);
+
+    if (character.skeleton != nullptr)
+    {
+        {
+            ANIMATION_PROFILE_SCOPE(ProfileHierarchy);
+            ApplyPose(character);
+            propagate(character);
+        }
+        SolveIK(character);
+    }
+
+    character.lastUpdateMicroseconds = ElapsedMicroseconds(start);
+}
+
+void UpdateCharacter(CharacterInstance& character, float deltaTime)
+{
+    UpdateCharacterStages(character, deltaTime, PropagatePose);
+}
+
+void UpdateCharacters(JobSystem& jobs, CharacterInstance* characters, int count, float deltaTime, const AnimationUpdateSettings& settings)
+{
+    BeginArenaFrame();
+    jobs.ParallelFor(count, settings.characterGrainSize, [&](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            CharacterInstance& character = characters[i];
+            bool splitHierarchy = settings.subtreeSplitBoneCount > 0 && character.skeleton != nullptr
+                && character.skeleton->GetBoneCount() >= settings.subtreeSplitBoneCount && character.requiredBones.empty();
+
+            if (!splitHierarchy)
+            {
+                UpdateCharacter(character, deltaTime);
+                continue;
+            }
+
+            // Ancestors first, then independent subtrees in parallel. Both skip clean bones and compute every
+            // other bone exactly as the serial path does; a span only touches the dirty flags of its own subtree.
+            UpdateCharacterStages(character, deltaTime, [&](CharacterInstance& splitCharacter)
+            {
+                Skeleton& skeleton = *splitCharacter.skeleton;
+                skeleton.SplitWorldPoseUpdate(settings.maxSubtreeSpanBones, splitCharacter.serialBones, splitCharacter.boneSpans);
+                skeleton.UpdateWorldPoses(splitCharacter.serialBones.data(), splitCharacter.serialBones.size());
+
+                jobs.ParallelFor(splitCharacter.boneSpans.size(), 1, [&](int spanBegin, int spanEnd)
+                {
+                    for (int span = spanBegin; span < spanEnd; span++)
+                    {
+                        skeleton.UpdateWorldPoses(splitCharacter.boneSpans[span]);
+                    }
+                });
+                ANIMATION_PROFILE_COUNT(CounterBonesProcessed, skeleton.GetBoneCount());
+            });
+        }
+    });
+}
@@ -0,0 +1,444 @@
+#include "../Headers/BlendSpace2D.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static const float BarycentricEpsilon = 1e-5f;
+
+struct DelaunayTriangle
+{
+    int vertices[3];
+    double centerX, centerY;
+    double radiusSquared;
+};
+
+static DelaunayTriangle MakeDelaunayTriangle(const std::vector<double>& xs, const std::vector<double>& ys, int a, int b, int c)
+{
+    DelaunayTriangle triangle = { { a, b, c }, 0.0f, 0.0f, 0.0f };
+
+    double ax = xs[a], ay = ys[a];
+    double bx = xs[b], by = ys[b];
+    double cx = xs[c], cy = ys[c];
+    double d = 2.0f * (ax * (by - cy) + bx * (cy - ay) + cx * (ay - by));
+
+    // Degenerate triangles get an infinite circumcircle so the next insertion removes them
+    if (std::abs(d) < 1e-12)
+    {
+        triangle.radiusSquared = INFINITY;
+        return triangle;
+    }
+
+    double a2 = ax * ax + ay * ay;
+    double b2 = bx * bx + by * by;
+    double c2 = cx * cx + cy * cy;
+    triangle.centerX = (a2 * (by - cy) + b2 * (cy - ay) + c2 * (ay - by)) / d;
+    triangle.centerY = (a2 * (cx - bx) + b2 * (ax - cx) + c2 * (bx - ax)) / d;
+    triangle.radiusSquared = (ax - triangle.centerX) * (ax - triangle.centerX) + (ay - triangle.centerY) * (ay - triangle.centerY);
+    return triangle;
+}
+
+void BlendSpace2D::addAnimation(float x, float y, AnimationClip* clip)
+{
+    points.push_back({ x, y });
+    clips.push_back(clip);
+
+    triangulate();
+    buildGrid();
+}
+
+void BlendSpace2D::triangulate()
+{
+    triangles.clear();
+    hullEdges.clear();
+
+    int pointCount = points.size();
+    if (pointCount < 2)
+    {
+        return;
+    }
+
+    float minX = points[0].x, maxX = points[0].x;
+    float minY = points[0].y, maxY = points[0].y;
+    for (const BlendPoint& point : points)
+    {
+        minX = std::min(minX, point.x);
+        maxX = std::max(maxX, point.x);
+        minY = std::min(minY, point.y);
+        maxY = std::max(maxY, point.y);
+    }
+
+    // Bowyer-Watson, with a super triangle appended after the clip points
+    float span = std::max(std::max(maxX - minX, maxY - minY), 1.0f);
+    float midX = (minX + maxX) * 0.5f;
+    float midY = (minY + maxY) * 0.5f;
+
+    std::vector<double> xs, ys;
+    for (const BlendPoint& point : points)
+    {
+        xs.push_back(point.x);
+        ys.push_back(point.y);
+    }
+    xs.push_back(midX - 100.0f * span);
+    ys.push_back(midY - span);
+    xs.push_back(midX);
+    ys.push_back(midY + 100.0f * span);
+    xs.push_back(midX + 100.0f * span);
+    ys.push_back(midY - span);
+
+    std::vector<DelaunayTriangle> working = { MakeDelaunayTriangle(xs, ys, pointCount, pointCount + 1, pointCount + 2) };
+    std::vector<BlendEdge> polygon;
+
+    for (int i = 0; i < pointCount; i++)
+    {
+        // Coincident clips would create degenerate triangles; the first one wins
+        bool duplicate = false;
+        for (int j = 0; j < i && !duplicate; j++)
+        {
+            duplicate = std::abs(xs[i] - xs[j]) < BarycentricEpsilon && std::abs(ys[i] - ys[j]) < BarycentricEpsilon;
+        }
+        if (duplicate)
+        {
+            continue;
+        }
+
+        polygon.clear();
+        std::vector<DelaunayTriangle> kept;
+
+        for (const DelaunayTriangle& triangle : working)
+        {
+            // Points on the circumcircle count as inside, so cocircular clips never leave slivers
+            double dx = xs[i] - triangle.centerX;
+            double dy = ys[i] - triangle.centerY;
+            if (dx * dx + dy * dy > triangle.radiusSquared * (1.0 + 1e-9))
+            {
+                kept.push_back(triangle);
+                continue;
+            }
+
+            // Edges shared by two removed triangles cancel out, the rest bound the cavity
+            for (int e = 0; e < 3; e++)
+            {
+                BlendEdge edge = { triangle.vertices[e], triangle.vertices[(e + 1) % 3] };
+                auto shared = std::find_if(polygon.begin(), polygon.end(), [&](const BlendEdge& other)
+                {
+                    return (other.a == edge.a && other.b == edge.b) || (other.a == edge.b && other.b == edge.a);
+                });
+
+                if (shared != polygon.end())
+                {
+                    polygon.erase(shared);
+                }
+                else
+                {
+                    polygon.push_back(edge);
+                }
+            }
+        }
+
+        for (const BlendEdge& edge : polygon)
+        {
+            kept.push_back(MakeDelaunayTriangle(xs, ys, edge.a, edge.b, i));
+        }
+
+        working.swap(kept);
+    }
+
+    for (const DelaunayTriangle& triangle : working)
+    {
+        int a = triangle.vertices[0], b = triangle.vertices[1], c = triangle.vertices[2];
+        if (a >= pointCount || b >= pointCount || c >= pointCount)
+        {
+            continue;
+        }
+
+        float e1x = points[b].x - points[a].x, e1y = points[b].y - points[a].y;
+        float e2x = points[c].x - points[a].x, e2y = points[c].y - points[a].y;
+        float determinant = e1x * e2y - e2x * e1y;
+        if (std::abs(determinant) < 1e-6f * span * span)
+        {
+            continue;
+        }
+
+        BlendTriangle blendTriangle;
+        blendTriangle.vertices[0] = a;
+        blendTriangle.vertices[1] = b;
+        blendTriangle.vertices[2] = c;
+        blendTriangle.originX = points[a].x;
+        blendTriangle.originY = points[a].y;
+        blendTriangle.inverse[0] = e2y / determinant;
+        blendTriangle.inverse[1] = -e2x / determinant;
+        blendTriangle.inverse[2] = -e1y / determinant;
+        blendTriangle.inverse[3] = e1x / determinant;
+        triangles.push_back(blendTriangle);
+    }
+
+    // Hull edges belong to exactly one triangle
+    for (int t = 0; t < triangles.size(); t++)
+    {
+        for (int e = 0; e < 3; e++)
+        {
+            int a = triangles[t].vertices[e];
+            int b = triangles[t].vertices[(e + 1) % 3];
+            bool shared = false;
+
+            for (int other = 0; other < triangles.size() && !shared; other++)
+            {
+                if (other == t)
+                {
+                    continue;
+                }
+
+                for (int f = 0; f < 3 && !shared; f++)
+                {
+                    int c = triangles[other].vertices[f];
+                    int d = triangles[other].vertices[(f + 1) % 3];
+                    shared = (a == d && b == c) || (a == c && b == d);
+                }
+            }
+
+            if (!shared)
+            {
+                hullEdges.push_back({ a, b });
+            }
+        }
+    }
+
+    // Collinear clips have no triangles: chain them along the line instead
+    if (triangles.empty())
+    {
+        int farthest = 0;
+        float farthestDistance = 0.0f;
+        for (int i = 1; i < pointCount; i++)
+        {
+            float dx = points[i].x - points[0].x;
+            float dy = points[i].y - points[0].y;
+            if (dx * dx + dy * dy > farthestDistance)
+            {
+                farthestDistance = dx * dx + dy * dy;
+                farthest = i;
+            }
+        }
+
+        float directionX = points[farthest].x - points[0].x;
+        float directionY = points[farthest].y - points[0].y;
+        std::vector<int> order(pointCount);
+        for (int i = 0; i < pointCount; i++)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&](int a, int b)
+        {
+            return points[a].x * directionX + points[a].y * directionY < points[b].x * directionX + points[b].y * directionY;
+        });
+
+        for (int i = 0; i + 1 < pointCount; i++)
+        {
+            hullEdges.push_back({ order[i], order[i + 1] });
+        }
+    }
+}
+
+void BlendSpace2D::buildGrid()
+{
+    cellTriangleStart.clear();
+    cellTriangles.clear();
+    gridSize = 0;
+
+    if (triangles.empty())
+    {
+        return;
+    }
+
+    float minX = points[0].x, maxX = points[0].x;
+    float minY = points[0].y, maxY = points[0].y;
+    for (const BlendPoint& point : points)
+    {
+        minX = std::min(minX, point.x);
+        maxX = std::max(maxX, point.x);
+        minY = std::min(minY, point.y);
+        maxY = std::max(maxY, point.y);
+    }
+
+    // About one triangle per cell
+    gridSize = std::max(1, (int)std::ceil(std::sqrt((float)triangles.size())));
+    gridMinX = minX;
+    gridMinY = minY;
+    cellSizeX = std::max(maxX - minX, 1e-6f) / gridSize;
+    cellSizeY = std::max(maxY - minY, 1e-6f) / gridSize;
+
+    // Conservative: every cell overlapped by a triangle's bounding box
+    std::vector<std::vector<int>> cells(gridSize * gridSize);
+    for (int t = 0; t < triangles.size(); t++)
+    {
+        const int* v = triangles[t].vertices;
+        float triangleMinX = std::min(points[v[0]].x, std::min(points[v[1]].x, points[v[2]].x));
+        float triangleMaxX = std::max(points[v[0]].x, std::max(points[v[1]].x, points[v[2]].x));
+        float triangleMinY = std::min(points[v[0]].y, std::min(points[v[1]].y, points[v[2]].y));
+        float triangleMaxY = std::max(points[v[0]].y, std::max(points[v[1]].y, points[v[2]].y));
+
+        int cellMinX = std::clamp((int)((triangleMinX - gridMinX) / cellSizeX), 0, gridSize - 1);
+        int cellMaxX = std::clamp((int)((triangleMaxX - gridMinX) / cellSizeX), 0, gridSize - 1);
+        int cellMinY = std::clamp((int)((triangleMinY - gridMinY) / cellSizeY), 0, gridSize - 1);
+        int cellMaxY = std::clamp((int)((triangleMaxY - gridMinY) / cellSizeY), 0, gridSize - 1);
+
+        for (int cy = cellMinY; cy <= cellMaxY; cy++)
+        {
+            for (int cx = cellMinX; cx <= cellMaxX; cx++)
+            {
+                cells[cy * gridSize + cx].push_back(t);
+            }
+        }
+    }
+
+    for (const std::vector<int>& cell : cells)
+    {
+        cellTriangleStart.push_back(cellTriangles.size());
+        cellTriangles.insert(cellTriangles.end(), cell.begin(), cell.end());
+    }
+    cellTriangleStart.push_back(cellTriangles.size());
+}
+
+bool BlendSpace2D::findTriangle(float x, float y, BlendWeights2D& outWeights) const
+{
+    if (gridSize == 0)
+    {
+        return false;
+    }
+
+    float localX = (x - gridMinX) / cellSizeX;
+    float localY = (y - gridMinY) / cellSizeY;
+    if (localX < -BarycentricEpsilon || localY < -BarycentricEpsilon || localX > gridSize + BarycentricEpsilon || localY > gridSize + BarycentricEpsilon)
+    {
+        return false;
+    }
+
+    int cellX = std::clamp((int)localX, 0, gridSize - 1);
+    int cellY = std::clamp((int)localY, 0, gridSize - 1);
+    int cell = cellY * gridSize + cellX;
+
+    for (int i = cellTriangleStart[cell]; i < cellTriangleStart[cell + 1]; i++)
+    {
+        const BlendTriangle& triangle = triangles[cellTriangles[i]];
+        float dx = x - triangle.originX;
+        float dy = y - triangle.originY;
+        float v = triangle.inverse[0] * dx + triangle.inverse[1] * dy;
+        float w = triangle.inverse[2] * dx + triangle.inverse[3] * dy;
+        float u = 1.0f - v - w;
+
+        if (u < -BarycentricEpsilon || v < -BarycentricEpsilon || w < -BarycentricEpsilon)
+        {
+            continue;
+        }
+
+        float barycentric[3] = { std::max(u, 0.0f), std::max(v, 0.0f), std::max(w, 0.0f) };
+        float total = barycentric[0] + barycentric[1] + barycentric[2];
+
+        outWeights.count = 0;
+        for (int k = 0; k < 3; k++)
+        {
+            if (barycentric[k] > 0.0f)
+            {
+                outWeights.samples[outWeights.count++] = { triangle.vertices[k], barycentric[k] / total };
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void BlendSpace2D::projectOnHull(float x, float y, BlendWeights2D& outWeights) const
+{
+    int bestA = 0;
+    int bestB = 0;
+    float bestT = 0.0f;
+    float bestDistance = INFINITY;
+
+    for (const BlendEdge& edge : hullEdges)
+    {
+        const BlendPoint& a = points[edge.a];
+        const BlendPoint& b = points[edge.b];
+        float edgeX = b.x - a.x;
+        float edgeY = b.y - a.y;
+        float lengthSquared = edgeX * edgeX + edgeY * edgeY;
+        float t = lengthSquared > 0.0f ? std::clamp(((x - a.x) * edgeX + (y - a.y) * edgeY) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+
+        float dx = a.x + edgeX * t - x;
+        float dy = a.y + edgeY * t - y;
+        float distance = dx * dx + dy * dy;
+        if (distance < bestDistance)
+        {
+            bestDistance = distance;
+            bestA = edge.a;
+            bestB = edge.b;
+            bestT = t;
+        }
+    }
+
+    outWeights.count = 0;
+    if (bestT < 1.0f)
+    {
+        outWeights.samples[outWeights.count++] = { bestA, 1.0f - bestT };
+    }
+    if (bestT > 0.0f)
+    {
+        outWeights.samples[outWeights.count++] = { bestB, bestT };
+    }
+}
+
+BlendWeights2D BlendSpace2D::calculateWeights(float x, float y) const
+{
+    BlendWeights2D weights = BlendWeights2D();
+
+    if (clips.empty())
+    {
+        return weights;
+    }
+
+    if (clips.size() == 1)
+    {
+        weights.samples[0] = { 0, 1.0f };
+        weights.count = 1;
+        return weights;
+    }
+
+    if (!findTriangle(x, y, weights))
+    {
+        projectOnHull(x, y, weights);
+    }
+
+    return weights;
+}
+
+void BlendSpace2D::printWeights(float x, float y) const
+{
+    BlendWeights2D weights = calculateWeights(x, y);
+
+    std::cout << "[";
+    for (int i = 0; i < weights.count; i++)
+    {
+        std::cout << weights.samples[i].clipIndex << ":" << weights.samples[i].weight << ",";
+    }
+    std::cout << "]" << std::endl;
+}
+
+int BlendSpace2D::getClipCount() const
+{
+    return clips.size();
+}
+
+AnimationClip* BlendSpace2D::getClip(int index) const
+{
+    if (index < 0 || index >= clips.size())
+    {
+        return nullptr;
+    }
+
+    return clips[index];
+}
+
+int BlendSpace2D::getTriangleCount() const
+{
+    return triangles.size();
+}
@@ -1,53 +1,82 @@
 #include "../Headers/BlendTree1D.h"
 
+#include <algorithm>
 #include <iostream>
 
 void BlendTree1D::addAnimation(float threshold, AnimationClip* clip)
 {
-    thresholds.push_back(threshold);
-    clips.push_back(clip);
+    // After any equal thresholds, so ties keep insertion order
+    int index = std::upper_bound(thresholds.begin(), thresholds.end(), threshold) - thresholds.begin();
+    thresholds.insert(thresholds.begin() + index, threshold);
+    clips.insert(clips.begin() + index, clip);
 }
 
-std::vector<float> BlendTree1D::calculateWeights(float parameter)
+BlendWeights1D CalculateBlendWeights1D(const float* thresholds, int thresholdCount, float parameter)
 {
-    std::vector<float> weights(clips.size(), 0.0f);
+    BlendWeights1D weights = BlendWeights1D();
 
-    if (parameter <= thresholds[0])
+    if (thresholdCount == 0)
     {
-        weights[0] = 1.0f;
         return weights;
     }
 
-    if (parameter >= thresholds[thresholds.size() - 1])
+    if (parameter <= thresholds[0])
     {
-        weights[thresholds.size() - 1] = 1.0f;
+        weights.samples[0] = { 0, 1.0f };
+        weights.count = 1;
         return weights;
     }
 
-    int intervalIndex = 0;
-    float threshold1 = 0.0f;
-    float threshold2 = 0.0f;
-
-    for (int i = 0; i <= thresholds.size() - 2; i++)
+    if (parameter >= thresholds[thresholdCount - 1])
     {
-        if (thresholds[i] <= parameter && parameter < thresholds[i + 1])
-        {
-            intervalIndex = i;
+        weights.samples[0] = { thresholdCount - 1, 1.0f };
+        weights.count = 1;
+        return weights;
+    }
+
+    // Last threshold <= parameter; the clamps above guarantee 0 <= i < thresholdCount - 1
+    int i = std::upper_bound(thresholds, thresholds + thresholdCount, parameter) - thresholds - 1;
+    float threshold1 = thresholds[i];
+    float threshold2 = thresholds[i + 1];
+    float weight2 = (parameter - threshold1) / (threshold2 - threshold1);
 
-            threshold1 = thresholds[intervalIndex];
-            threshold2 = thresholds[intervalIndex + 1];
+    weights.samples[0] = { i, 1.0f - weight2 };
+    weights.count = 1;
 
-            weights[i] = (threshold2 - parameter) / (threshold2 - threshold1);
-            weights[i + 1] = (parameter - threshold1) / (threshold2 - threshold1);
-        }
+    if (weight2 > 0.0f)
+    {
+        weights.samples[1] = { i + 1, weight2 };
+        weights.count = 2;
     }
 
     return weights;
 }
 
-void BlendTree1D::printWeights(float parameter)
+BlendWeights1D BlendTree1D::calculateWeights(float parameter) const
+{
+    return CalculateBlendWeights1D(thresholds.data(), thresholds.size(), parameter);
+}
+
+void BlendTree1D::calculateWeights(const float* parameters, BlendWeights1D* outWeights, int count) const
+{
+    const float* thresholdData = thresholds.data();
+    int thresholdCount = thresholds.size();
+
+    for (int i = 0; i < count; i++)
+    {
+        outWeights[i] = CalculateBlendWeights1D(thresholdData, thresholdCount, parameters[i]);
+    }
+}
+
+void BlendTree1D::printWeights(float parameter) const
 {
-    std::vector<float> NewWeights = calculateWeights(parameter);
+    BlendWeights1D weights = calculateWeights(parameter);
+    std::vector<float> NewWeights(clips.size(), 0.0f);
+
+    for (int i = 0; i < weights.count; i++)
+    {
+        NewWeights[weights.samples[i].clipIndex] = weights.samples[i].weight;
+    }
 
     std::cout << "[";
     for (float weight : NewWeights)
@@ -56,3 +85,18 @@ void BlendTree1D::printWeights(float parameter)
     }
     std::cout << "]" << std::endl;
 }
+
+int BlendTree1D::getClipCount() const
+{
+    return clips.size();
+}
+
+AnimationClip* BlendTree1D::getClip(int index) const
+{
+    if (index < 0 || index >= clips.size())
+    {
+        return nullptr;
+    }
+
+    return clips[index];
+}
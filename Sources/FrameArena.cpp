@@ -0,0 +1,169 @@
+#include "../Headers/FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+static const size_t MinBlockSize = 64 * 1024;
+
+FrameArena::FrameArena(size_t initialCapacity) : capacity(0), peakBytes(0), blockAllocationCount(0)
+{
+    if (initialCapacity > 0)
+    {
+        AddBlock(initialCapacity);
+    }
+}
+
+void FrameArena::AddBlock(size_t size)
+{
+    size_t start = capacity.load(std::memory_order_relaxed);
+    blocks.push_back({ std::unique_ptr<unsigned char[]>(new unsigned char[size]), size, start });
+    capacity.store(start + size, std::memory_order_relaxed);
+    blockAllocationCount.store(blockAllocationCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+    while (currentBlock < blocks.size())
+    {
+        Block& block = blocks[currentBlock];
+        uintptr_t base = (uintptr_t)block.memory.get();
+        size_t start = ((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+
+        if (start + size <= block.size)
+        {
+            offset = start + size;
+            size_t used = block.start + offset;
+            if (used > peakBytes.load(std::memory_order_relaxed))
+            {
+                peakBytes.store(used, std::memory_order_relaxed);
+            }
+            return block.memory.get() + start;
+        }
+
+        // Blocks kept after a rewind are reused before growing
+        if (currentBlock + 1 >= blocks.size())
+        {
+            break;
+        }
+        currentBlock++;
+        offset = 0;
+    }
+
+    // Doubles the capacity, so a frame needs few blocks even from an empty arena
+    AddBlock(std::max({ size + alignment, capacity.load(std::memory_order_relaxed), MinBlockSize }));
+    currentBlock = blocks.size() - 1;
+    offset = 0;
+    return Allocate(size, alignment);
+}
+
+FrameArenaMarker FrameArena::GetMarker() const
+{
+    FrameArenaMarker marker;
+    marker.block = currentBlock;
+    marker.offset = offset;
+    return marker;
+}
+
+void FrameArena::Rewind(const FrameArenaMarker& marker)
+{
+    currentBlock = marker.block;
+    offset = marker.offset;
+}
+
+void FrameArena::Reset()
+{
+    if (blocks.size() > 1)
+    {
+        size_t total = capacity.load(std::memory_order_relaxed);
+        blocks.clear();
+        capacity.store(0, std::memory_order_relaxed);
+        AddBlock(total);
+    }
+
+    currentBlock = 0;
+    offset = 0;
+}
+
+size_t FrameArena::GetUsedBytes() const
+{
+    return currentBlock < blocks.size() ? blocks[currentBlock].start + offset : 0;
+}
+
+size_t FrameArena::GetCapacity() const
+{
+    return capacity.load(std::memory_order_relaxed);
+}
+
+size_t FrameArena::GetPeakBytes() const
+{
+    return peakBytes.load(std::memory_order_relaxed);
+}
+
+int FrameArena::GetBlockAllocationCount() const
+{
+    return blockAllocationCount.load(std::memory_order_relaxed);
+}
+
+static std::atomic<uint64_t> arenaFrame(0);
+
+struct ThreadFrameArena;
+
+// Live thread arenas, so statistics can be gathered from any thread
+static std::mutex arenaRegistryMutex;
+static std::vector<ThreadFrameArena*> arenaRegistry;
+
+struct ThreadFrameArena
+{
+    FrameArena arena;
+    uint64_t frame;
+
+    ThreadFrameArena() : frame(arenaFrame.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(arenaRegistryMutex);
+        arenaRegistry.push_back(this);
+    }
+
+    ~ThreadFrameArena()
+    {
+        std::lock_guard<std::mutex> lock(arenaRegistryMutex);
+        arenaRegistry.erase(std::find(arenaRegistry.begin(), arenaRegistry.end(), this));
+    }
+};
+
+FrameArena& GetThreadFrameArena()
+{
+    static thread_local ThreadFrameArena thread;
+
+    uint64_t frame = arenaFrame.load(std::memory_order_relaxed);
+    if (thread.frame != frame)
+    {
+        thread.frame = frame;
+        thread.arena.Reset();
+    }
+
+    return thread.arena;
+}
+
+void BeginArenaFrame()
+{
+    arenaFrame.fetch_add(1, std::memory_order_relaxed);
+}
+
+FrameArenaStatistics GetFrameArenaStatistics()
+{
+    std::lock_guard<std::mutex> lock(arenaRegistryMutex);
+
+    FrameArenaStatistics statistics;
+    statistics.arenaCount = arenaRegistry.size();
+    for (const ThreadFrameArena* thread : arenaRegistry)
+    {
+        size_t peak = thread->arena.GetPeakBytes();
+        statistics.capacity += thread->arena.GetCapacity();
+        statistics.peakBytes += peak;
+        statistics.maxArenaPeakBytes = std::max(statistics.maxArenaPeakBytes, peak);
+        statistics.blockAllocationCount += thread->arena.GetBlockAllocationCount();
+    }
+
+    return statistics;
+}
@@ -1,17 +1,30 @@
 #include "../Headers/IKSolver.h"
+#include "../Headers/AnimationProfiler.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ANIMATION_SIMD_SSE 1
+#include <immintrin.h>
+#else
+#define ANIMATION_SIMD_SSE 0
+#endif
+
+static const float IKEpsilon = 0.000001f;
 
 IKResult SolveTwoBoneIK(const Vector3& start, const Vector3& target, const IKChain& chain)
 {
 	IKResult result = IKResult();
-	
-	float distance = std::sqrt(std::pow(start.x - target.x, 2) + std::pow(start.y - target.y, 2) + std::pow(start.z - target.z, 2));
+
+	Vector3 toTarget = target - start;
+	float distanceSquared = toTarget.x * toTarget.x + toTarget.y * toTarget.y + toTarget.z * toTarget.z;
+	float distance = std::sqrt(distanceSquared);
 
 	float chainLength = chain.lowerLength + chain.upperLength;
 	float maxReach = chainLength;
 	float minReach = std::abs(chain.lowerLength - chain.upperLength);
 
-	float EPSILON = 0.000001f;
-	if (distance < minReach || distance > maxReach || distance < EPSILON)
+	if (distance < minReach || distance > maxReach || distance < IKEpsilon)
 	{
 		result.shoulderAngle = 0.0f;
 		result.elbowAngle = 0.0f;
@@ -23,18 +36,617 @@ IKResult SolveTwoBoneIK(const Vector3& start, const Vector3& target, const IKCha
 		result.isReachable = true;
 	}
 
+	float upperSquared = chain.upperLength * chain.upperLength;
+	float lowerSquared = chain.lowerLength * chain.lowerLength;
+
 	float elbowAngle = 0.0f;
-	elbowAngle = std::acos(Clamp((std::pow(chain.lowerLength, 2) + std::pow(chain.upperLength, 2) - std::pow(distance, 2)) / (2 * chain.lowerLength * chain.upperLength), -1 , 1));
+	elbowAngle = std::acos(Clamp((lowerSquared + upperSquared - distanceSquared) / (2.0f * chain.lowerLength * chain.upperLength), -1.0f, 1.0f));
 	result.elbowAngle = elbowAngle;
 
 	float shoulderAngle = 0.0f;
 	float angleToTarget = 0.0f;
 	float internalAngle = 0.0f;
 
+	// Angle at the shoulder, opposite the lower bone
 	angleToTarget = std::atan2(target.y - start.y, target.x - start.x);
-	internalAngle = std::acos(Clamp((std::pow(chain.lowerLength, 2) + std::pow(distance, 2) - std::pow(chain.upperLength, 2)) / (2 * chain.lowerLength * distance), -1, 1));
+	internalAngle = std::acos(Clamp((upperSquared + distanceSquared - lowerSquared) / (2.0f * chain.upperLength * distance), -1.0f, 1.0f));
 	shoulderAngle = angleToTarget + internalAngle;
 	result.shoulderAngle = shoulderAngle;
 
 	return result;
 }
+
+// Unit vector perpendicular to direction, toward the pole when the pole is off the start-target line
+static Vector3 GetBendDirection(const Vector3& direction, const Vector3& toPole)
+{
+	Vector3 bend = toPole - direction * Dot(toPole, direction);
+	if (Dot(bend, bend) > IKEpsilon)
+	{
+		return Normalize(bend);
+	}
+
+	Vector3 fallback = Cross(direction, Vector3(0.0f, 0.0f, 1.0f));
+	if (Dot(fallback, fallback) <= IKEpsilon)
+	{
+		fallback = Cross(direction, Vector3(0.0f, 1.0f, 0.0f));
+	}
+	return Normalize(Cross(fallback, direction));
+}
+
+// Rotation whose columns are the given orthonormal axes
+static Quaternion FromBasis(const Vector3& xAxis, const Vector3& yAxis, const Vector3& zAxis)
+{
+	float trace = xAxis.x + yAxis.y + zAxis.z;
+
+	if (trace > 0.0f)
+	{
+		float s = 0.5f / std::sqrt(trace + 1.0f);
+		return Normalize(Quaternion((yAxis.z - zAxis.y) * s, (zAxis.x - xAxis.z) * s, (xAxis.y - yAxis.x) * s, 0.25f / s));
+	}
+
+	if (xAxis.x > yAxis.y && xAxis.x > zAxis.z)
+	{
+		float s = 2.0f * std::sqrt(1.0f + xAxis.x - yAxis.y - zAxis.z);
+		return Normalize(Quaternion(0.25f * s, (yAxis.x + xAxis.y) / s, (zAxis.x + xAxis.z) / s, (yAxis.z - zAxis.y) / s));
+	}
+
+	if (yAxis.y > zAxis.z)
+	{
+		float s = 2.0f * std::sqrt(1.0f + yAxis.y - xAxis.x - zAxis.z);
+		return Normalize(Quaternion((yAxis.x + xAxis.y) / s, 0.25f * s, (zAxis.y + yAxis.z) / s, (zAxis.x - xAxis.z) / s));
+	}
+
+	float s = 2.0f * std::sqrt(1.0f + zAxis.z - xAxis.x - yAxis.y);
+	return Normalize(Quaternion((zAxis.x + xAxis.z) / s, (zAxis.y + yAxis.z) / s, 0.25f * s, (xAxis.y - yAxis.x) / s));
+}
+
+IKResult3D SolveTwoBoneIK(const Vector3& start, const Vector3& target, const Vector3& pole, const IKChain& chain)
+{
+	IKResult3D result = IKResult3D();
+
+	Vector3 toTarget = target - start;
+	float distance = Length(toTarget);
+	float maxReach = chain.upperLength + chain.lowerLength;
+	float minReach = std::abs(chain.upperLength - chain.lowerLength);
+
+	result.isReachable = distance >= minReach && distance <= maxReach && distance >= IKEpsilon;
+
+	Vector3 direction = distance >= IKEpsilon ? toTarget * (1.0f / distance) : Vector3(1.0f, 0.0f, 0.0f);
+	float reach = Clamp(distance, std::max(minReach, IKEpsilon), maxReach);
+
+	// Law of cosines gives the shoulder angle's cosine directly, no trig needed
+	float cosShoulder = Clamp((chain.upperLength * chain.upperLength + reach * reach - chain.lowerLength * chain.lowerLength) / (2.0f * chain.upperLength * reach), -1.0f, 1.0f);
+	float sinShoulder = std::sqrt(std::max(0.0f, 1.0f - cosShoulder * cosShoulder));
+
+	Vector3 bend = GetBendDirection(direction, pole - start);
+	Vector3 normal = Cross(direction, bend);
+	Vector3 upperDirection = direction * cosShoulder + bend * sinShoulder;
+
+	result.elbowPosition = start + upperDirection * chain.upperLength;
+	result.endPosition = start + direction * reach;
+
+	Vector3 lowerDirection = Normalize(result.endPosition - result.elbowPosition);
+	result.upperRotation = FromBasis(upperDirection, Cross(normal, upperDirection), normal);
+	result.lowerRotation = FromBasis(lowerDirection, Cross(normal, lowerDirection), normal);
+
+	return result;
+}
+
+int IKBatch::GetCount() const
+{
+	return startX.size();
+}
+
+void IKBatch::Resize(int count)
+{
+	std::vector<float>* streams[] = {
+		&startX, &startY, &startZ, &targetX, &targetY, &targetZ, &poleX, &poleY, &poleZ, &upperLength, &lowerLength,
+		&elbowX, &elbowY, &elbowZ, &endX, &endY, &endZ,
+		&upperRotationX, &upperRotationY, &upperRotationZ, &upperRotationW,
+		&lowerRotationX, &lowerRotationY, &lowerRotationZ, &lowerRotationW
+	};
+
+	for (std::vector<float>* stream : streams)
+	{
+		stream->resize(count, 0.0f);
+	}
+	reachable.resize(count, 0);
+}
+
+void IKBatch::SetChain(int index, const Vector3& start, const Vector3& target, const Vector3& pole, const IKChain& chain)
+{
+	startX[index] = start.x;
+	startY[index] = start.y;
+	startZ[index] = start.z;
+	targetX[index] = target.x;
+	targetY[index] = target.y;
+	targetZ[index] = target.z;
+	poleX[index] = pole.x;
+	poleY[index] = pole.y;
+	poleZ[index] = pole.z;
+	upperLength[index] = chain.upperLength;
+	lowerLength[index] = chain.lowerLength;
+}
+
+IKResult3D IKBatch::GetResult(int index) const
+{
+	IKResult3D result = IKResult3D();
+	result.upperRotation = Quaternion(upperRotationX[index], upperRotationY[index], upperRotationZ[index], upperRotationW[index]);
+	result.lowerRotation = Quaternion(lowerRotationX[index], lowerRotationY[index], lowerRotationZ[index], lowerRotationW[index]);
+	result.elbowPosition = Vector3(elbowX[index], elbowY[index], elbowZ[index]);
+	result.endPosition = Vector3(endX[index], endY[index], endZ[index]);
+	result.isReachable = reachable[index] != 0;
+	return result;
+}
+
+static void StoreResult(IKBatch& batch, int index, const IKResult3D& result)
+{
+	batch.upperRotationX[index] = result.upperRotation.x;
+	batch.upperRotationY[index] = result.upperRotation.y;
+	batch.upperRotationZ[index] = result.upperRotation.z;
+	batch.upperRotationW[index] = result.upperRotation.w;
+	batch.lowerRotationX[index] = result.lowerRotation.x;
+	batch.lowerRotationY[index] = result.lowerRotation.y;
+	batch.lowerRotationZ[index] = result.lowerRotation.z;
+	batch.lowerRotationW[index] = result.lowerRotation.w;
+	batch.elbowX[index] = result.elbowPosition.x;
+	batch.elbowY[index] = result.elbowPosition.y;
+	batch.elbowZ[index] = result.elbowPosition.z;
+	batch.endX[index] = result.endPosition.x;
+	batch.endY[index] = result.endPosition.y;
+	batch.endZ[index] = result.endPosition.z;
+	batch.reachable[index] = result.isReachable ? 1 : 0;
+}
+
+#if ANIMATION_SIMD_SSE
+// Four 3D vectors, one per lane
+struct Vector3x4
+{
+	__m128 x, y, z;
+};
+
+static inline Vector3x4 Load(const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z, int index)
+{
+	return { _mm_loadu_ps(&x[index]), _mm_loadu_ps(&y[index]), _mm_loadu_ps(&z[index]) };
+}
+
+static inline void Store(const Vector3x4& v, std::vector<float>& x, std::vector<float>& y, std::vector<float>& z, int index)
+{
+	_mm_storeu_ps(&x[index], v.x);
+	_mm_storeu_ps(&y[index], v.y);
+	_mm_storeu_ps(&z[index], v.z);
+}
+
+static inline Vector3x4 Add(const Vector3x4& a, const Vector3x4& b)
+{
+	return { _mm_add_ps(a.x, b.x), _mm_add_ps(a.y, b.y), _mm_add_ps(a.z, b.z) };
+}
+
+static inline Vector3x4 Subtract(const Vector3x4& a, const Vector3x4& b)
+{
+	return { _mm_sub_ps(a.x, b.x), _mm_sub_ps(a.y, b.y), _mm_sub_ps(a.z, b.z) };
+}
+
+static inline Vector3x4 Scale(const Vector3x4& v, __m128 s)
+{
+	return { _mm_mul_ps(v.x, s), _mm_mul_ps(v.y, s), _mm_mul_ps(v.z, s) };
+}
+
+static inline __m128 Dot(const Vector3x4& a, const Vector3x4& b)
+{
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+}
+
+static inline Vector3x4 Cross(const Vector3x4& a, const Vector3x4& b)
+{
+	return {
+		_mm_sub_ps(_mm_mul_ps(a.y, b.z), _mm_mul_ps(a.z, b.y)),
+		_mm_sub_ps(_mm_mul_ps(a.z, b.x), _mm_mul_ps(a.x, b.z)),
+		_mm_sub_ps(_mm_mul_ps(a.x, b.y), _mm_mul_ps(a.y, b.x))
+	};
+}
+
+static inline Vector3x4 Select(__m128 mask, const Vector3x4& a, const Vector3x4& b)
+{
+	return { _mm_or_ps(_mm_and_ps(mask, a.x), _mm_andnot_ps(mask, b.x)), _mm_or_ps(_mm_and_ps(mask, a.y), _mm_andnot_ps(mask, b.y)), _mm_or_ps(_mm_and_ps(mask, a.z), _mm_andnot_ps(mask, b.z)) };
+}
+
+// rsqrt plus one Newton-Raphson step
+static inline __m128 InverseSqrt(__m128 value)
+{
+	__m128 estimate = _mm_rsqrt_ps(value);
+	__m128 half = _mm_mul_ps(value, _mm_set1_ps(0.5f));
+	return _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(half, _mm_mul_ps(estimate, estimate))));
+}
+
+static inline Vector3x4 Normalize(const Vector3x4& v)
+{
+	return Scale(v, InverseSqrt(_mm_max_ps(Dot(v, v), _mm_set1_ps(1e-30f))));
+}
+
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Branchless rotation from orthonormal columns: each lane takes the scalar FromBasis branch for its largest
+// diagonal term, so the divisor stays away from zero and the signs match the scalar solve
+static inline void FromBasis(const Vector3x4& xAxis, const Vector3x4& yAxis, const Vector3x4& zAxis, __m128& qx, __m128& qy, __m128& qz, __m128& qw)
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	__m128 trace = _mm_add_ps(_mm_add_ps(xAxis.x, yAxis.y), zAxis.z);
+	__m128 useW = _mm_cmpgt_ps(trace, zero);
+	__m128 useX = _mm_andnot_ps(useW, _mm_and_ps(_mm_cmpgt_ps(xAxis.x, yAxis.y), _mm_cmpgt_ps(xAxis.x, zAxis.z)));
+	__m128 useY = _mm_andnot_ps(_mm_or_ps(useW, useX), _mm_cmpgt_ps(yAxis.y, zAxis.z));
+
+	__m128 traceW = _mm_add_ps(one, trace);
+	__m128 traceX = _mm_sub_ps(_mm_add_ps(one, xAxis.x), _mm_add_ps(yAxis.y, zAxis.z));
+	__m128 traceY = _mm_sub_ps(_mm_add_ps(one, yAxis.y), _mm_add_ps(xAxis.x, zAxis.z));
+	__m128 traceZ = _mm_sub_ps(_mm_add_ps(one, zAxis.z), _mm_add_ps(xAxis.x, yAxis.y));
+	__m128 selected = Select(useW, traceW, Select(useX, traceX, Select(useY, traceY, traceZ)));
+
+	__m128 differenceX = _mm_sub_ps(yAxis.z, zAxis.y);
+	__m128 differenceY = _mm_sub_ps(zAxis.x, xAxis.z);
+	__m128 differenceZ = _mm_sub_ps(xAxis.y, yAxis.x);
+	__m128 sumXY = _mm_add_ps(yAxis.x, xAxis.y);
+	__m128 sumXZ = _mm_add_ps(zAxis.x, xAxis.z);
+	__m128 sumYZ = _mm_add_ps(zAxis.y, yAxis.z);
+
+	// Every component is numerator * 0.5 / sqrt(selected), the branch's own component using selected itself
+	qx = Select(useW, differenceX, Select(useX, selected, Select(useY, sumXY, sumXZ)));
+	qy = Select(useW, differenceY, Select(useX, sumXY, Select(useY, selected, sumYZ)));
+	qz = Select(useW, differenceZ, Select(useX, sumXZ, Select(useY, sumYZ, selected)));
+	qw = Select(useW, selected, Select(useX, differenceX, Select(useY, differenceY, differenceZ)));
+
+	__m128 scale = _mm_mul_ps(half, InverseSqrt(_mm_max_ps(selected, _mm_set1_ps(1e-30f))));
+	qx = _mm_mul_ps(qx, scale);
+	qy = _mm_mul_ps(qy, scale);
+	qz = _mm_mul_ps(qz, scale);
+	qw = _mm_mul_ps(qw, scale);
+
+	__m128 inverseLength = InverseSqrt(_mm_add_ps(_mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy)), _mm_add_ps(_mm_mul_ps(qz, qz), _mm_mul_ps(qw, qw))));
+	qx = _mm_mul_ps(qx, inverseLength);
+	qy = _mm_mul_ps(qy, inverseLength);
+	qz = _mm_mul_ps(qz, inverseLength);
+	qw = _mm_mul_ps(qw, inverseLength);
+}
+#endif
+
+void SolveTwoBoneIKBatch(IKBatch& batch)
+{
+	ANIMATION_PROFILE_SCOPE(ProfileIK);
+	int count = batch.GetCount();
+	ANIMATION_PROFILE_COUNT(CounterIKSolves, count);
+	int i = 0;
+
+#if ANIMATION_SIMD_SSE
+	const __m128 epsilon = _mm_set1_ps(IKEpsilon);
+	const __m128 epsilonSquared = _mm_set1_ps(IKEpsilon * IKEpsilon);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const Vector3x4 axisX = { one, zero, zero };
+	const Vector3x4 axisY = { zero, one, zero };
+	const Vector3x4 axisZ = { zero, zero, one };
+
+	for (; i + 4 <= count; i += 4)
+	{
+		Vector3x4 start = Load(batch.startX, batch.startY, batch.startZ, i);
+		Vector3x4 target = Load(batch.targetX, batch.targetY, batch.targetZ, i);
+		Vector3x4 pole = Load(batch.poleX, batch.poleY, batch.poleZ, i);
+		__m128 upper = _mm_loadu_ps(&batch.upperLength[i]);
+		__m128 lower = _mm_loadu_ps(&batch.lowerLength[i]);
+
+		Vector3x4 toTarget = Subtract(target, start);
+		__m128 distanceSquared = Dot(toTarget, toTarget);
+		__m128 inverseDistance = InverseSqrt(_mm_max_ps(distanceSquared, epsilonSquared));
+		__m128 distance = _mm_mul_ps(distanceSquared, inverseDistance);
+
+		__m128 maxReach = _mm_add_ps(upper, lower);
+		__m128 minReach = _mm_and_ps(absMask, _mm_sub_ps(upper, lower));
+		__m128 reachableMask = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(distance, minReach), _mm_cmple_ps(distance, maxReach)), _mm_cmpge_ps(distance, epsilon));
+
+		__m128 hasDirection = _mm_cmpge_ps(distance, epsilon);
+		Vector3x4 direction = Select(hasDirection, Scale(toTarget, inverseDistance), axisX);
+		__m128 reach = _mm_min_ps(_mm_max_ps(distance, _mm_max_ps(minReach, epsilon)), maxReach);
+
+		__m128 cosShoulder = _mm_div_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(upper, upper), _mm_mul_ps(reach, reach)), _mm_mul_ps(lower, lower)), _mm_mul_ps(_mm_set1_ps(2.0f), _mm_mul_ps(upper, reach)));
+		cosShoulder = _mm_min_ps(_mm_max_ps(cosShoulder, _mm_set1_ps(-1.0f)), one);
+		__m128 sinShoulder = _mm_sqrt_ps(_mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(cosShoulder, cosShoulder))));
+
+		// Bend toward the pole, falling back to a fixed perpendicular when the pole is on the line
+		Vector3x4 toPole = Subtract(pole, start);
+		Vector3x4 bend = Subtract(toPole, Scale(direction, Dot(toPole, direction)));
+		Vector3x4 fallback = Cross(direction, axisZ);
+		fallback = Select(_mm_cmpgt_ps(Dot(fallback, fallback), epsilon), fallback, Cross(direction, axisY));
+		fallback = Cross(fallback, direction);
+		bend = Normalize(Select(_mm_cmpgt_ps(Dot(bend, bend), epsilon), bend, fallback));
+
+		Vector3x4 normal = Cross(direction, bend);
+		Vector3x4 upperDirection = Add(Scale(direction, cosShoulder), Scale(bend, sinShoulder));
+		Vector3x4 elbow = Add(start, Scale(upperDirection, upper));
+		Vector3x4 end = Add(start, Scale(direction, reach));
+		Vector3x4 lowerDirection = Normalize(Subtract(end, elbow));
+
+		__m128 qx, qy, qz, qw;
+		FromBasis(upperDirection, Cross(normal, upperDirection), normal, qx, qy, qz, qw);
+		_mm_storeu_ps(&batch.upperRotationX[i], qx);
+		_mm_storeu_ps(&batch.upperRotationY[i], qy);
+		_mm_storeu_ps(&batch.upperRotationZ[i], qz);
+		_mm_storeu_ps(&batch.upperRotationW[i], qw);
+
+		FromBasis(lowerDirection, Cross(normal, lowerDirection), normal, qx, qy, qz, qw);
+		_mm_storeu_ps(&batch.lowerRotationX[i], qx);
+		_mm_storeu_ps(&batch.lowerRotationY[i], qy);
+		_mm_storeu_ps(&batch.lowerRotationZ[i], qz);
+		_mm_storeu_ps(&batch.lowerRotationW[i], qw);
+
+		Store(elbow, batch.elbowX, batch.elbowY, batch.elbowZ, i);
+		Store(end, batch.endX, batch.endY, batch.endZ, i);
+
+		int reachableBits = _mm_movemask_ps(reachableMask);
+		for (int lane = 0; lane < 4; lane++)
+		{
+			batch.reachable[i + lane] = (reachableBits >> lane) & 1;
+		}
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		Vector3 start(batch.startX[i], batch.startY[i], batch.startZ[i]);
+		Vector3 target(batch.targetX[i], batch.targetY[i], batch.targetZ[i]);
+		Vector3 pole(batch.poleX[i], batch.poleY[i], batch.poleZ[i]);
+		IKChain chain = { batch.upperLength[i], batch.lowerLength[i] };
+		StoreResult(batch, i, SolveTwoBoneIK(start, target, pole, chain));
+	}
+}
+
+bool BuildIKBoneChain(const Skeleton& skeleton, int startBone, int endBone, IKBoneChain& outChain)
+{
+	outChain.bones.clear();
+	outChain.solvedRotations.clear();
+	outChain.hasSolution = false;
+
+	if (endBone < 0 || endBone >= skeleton.GetBoneCount() || startBone == endBone)
+	{
+		return false;
+	}
+
+	// Propagation parents, bounded so a cycle in the raw parent indices ends the walk
+	int boneCount = skeleton.GetBoneCount();
+	for (int bone = endBone; bone >= 0 && outChain.bones.size() < boneCount; bone = skeleton.GetUpdateParent(bone))
+	{
+		outChain.bones.push_back(bone);
+		if (bone == startBone)
+		{
+			std::reverse(outChain.bones.begin(), outChain.bones.end());
+			return true;
+		}
+	}
+
+	outChain.bones.clear();
+	return false;
+}
+
+// Composed from local poses so the result never depends on stale world poses
+static Transform GetWorldPoseFromLocals(const Skeleton& skeleton, int bone)
+{
+	// Ancestors up to the root, bounded like BuildIKBoneChain, then composed root first
+	int boneCount = skeleton.GetBoneCount();
+	std::vector<int> ancestors;
+	for (int ancestor = bone; ancestor >= 0 && ancestors.size() < boneCount; ancestor = skeleton.GetUpdateParent(ancestor))
+	{
+		ancestors.push_back(ancestor);
+	}
+
+	Transform world = skeleton.GetLocalPose(ancestors.back());
+	for (int i = ancestors.size() - 2; i >= 0; i--)
+	{
+		world = Combine(world, skeleton.GetLocalPose(ancestors[i]));
+	}
+	return world;
+}
+
+// Fills the chain's world positions and rotations, starting from the last solution when warm starting.
+// Returns the world rotation of the chain's parent.
+static Quaternion BeginChainSolve(const Skeleton& skeleton, IKBoneChain& chain, bool warmStart)
+{
+	int count = chain.bones.size();
+	chain.localPoses.resize(count);
+	chain.positions.resize(count);
+	chain.rotations.resize(count);
+	chain.lengths.resize(count - 1);
+
+	int parent = skeleton.GetUpdateParent(chain.bones[0]);
+	Transform world = parent >= 0 ? GetWorldPoseFromLocals(skeleton, parent) : Transform();
+	Quaternion parentRotation = world.rotation;
+
+	bool useSolution = warmStart && chain.hasSolution && chain.solvedRotations.size() == count - 1;
+
+	for (int i = 0; i < count; i++)
+	{
+		Transform local = skeleton.GetLocalPose(chain.bones[i]);
+		if (useSolution && i < count - 1)
+		{
+			local.rotation = chain.solvedRotations[i];
+		}
+
+		world = Combine(world, local);
+		chain.localPoses[i] = local;
+		chain.positions[i] = world.position;
+		chain.rotations[i] = world.rotation;
+
+		if (i > 0)
+		{
+			chain.lengths[i - 1] = Length(chain.positions[i] - chain.positions[i - 1]);
+		}
+	}
+
+	return parentRotation;
+}
+
+// Writes the chain's world rotations back as local rotations, end effector excluded
+static void EndChainSolve(Skeleton& skeleton, IKBoneChain& chain, Quaternion parentRotation)
+{
+	int count = chain.bones.size();
+	chain.solvedRotations.resize(count - 1);
+
+	for (int i = 0; i < count - 1; i++)
+	{
+		Transform local = chain.localPoses[i];
+		local.rotation = Normalize(Conjugate(parentRotation) * chain.rotations[i]);
+		skeleton.SetLocalTransform(chain.bones[i], local);
+
+		chain.solvedRotations[i] = local.rotation;
+		parentRotation = chain.rotations[i];
+	}
+
+	chain.hasSolution = true;
+}
+
+// Shortest rotation taking the direction of from onto the direction of to
+static Quaternion FromToRotation(const Vector3& from, const Vector3& to)
+{
+	float lengths = std::sqrt(Dot(from, from) * Dot(to, to));
+	if (lengths < IKEpsilon)
+	{
+		return Quaternion();
+	}
+
+	float w = lengths + Dot(from, to);
+	if (w < IKEpsilon * lengths)
+	{
+		// Opposite directions: half turn about any perpendicular axis
+		Vector3 axis = Cross(from, Vector3(1.0f, 0.0f, 0.0f));
+		if (Dot(axis, axis) < IKEpsilon * Dot(from, from))
+		{
+			axis = Cross(from, Vector3(0.0f, 1.0f, 0.0f));
+		}
+		axis = Normalize(axis);
+		return Quaternion(axis.x, axis.y, axis.z, 0.0f);
+	}
+
+	Vector3 axis = Cross(from, to);
+	return Normalize(Quaternion(axis.x, axis.y, axis.z, w));
+}
+
+// Rotates bone joint and everything below it about the joint's position
+static void RotateChain(IKBoneChain& chain, int joint, const Quaternion& rotation)
+{
+	Vector3 pivot = chain.positions[joint];
+	for (int i = joint; i < chain.positions.size(); i++)
+	{
+		chain.rotations[i] = Normalize(rotation * chain.rotations[i]);
+		chain.positions[i] = pivot + Rotate(rotation, chain.positions[i] - pivot);
+	}
+}
+
+static float GetChainLength(const IKBoneChain& chain)
+{
+	float length = 0.0f;
+	for (float boneLength : chain.lengths)
+	{
+		length += boneLength;
+	}
+	return length;
+}
+
+IKIterativeResult SolveFABRIK(Skeleton& skeleton, IKBoneChain& chain, const Vector3& target, const IKIterativeSettings& settings)
+{
+	ANIMATION_PROFILE_SCOPE(ProfileIK);
+	IKIterativeResult result = IKIterativeResult();
+	int count = chain.bones.size();
+	if (count < 2)
+	{
+		return result;
+	}
+
+	Quaternion parentRotation = BeginChainSolve(skeleton, chain, settings.warmStart);
+
+	Vector3 root = chain.positions[0];
+	std::vector<Vector3>& solved = chain.solvedPositions;
+	solved.assign(chain.positions.begin(), chain.positions.end());
+
+	result.isReachable = Length(target - root) <= GetChainLength(chain);
+	result.error = Length(solved[count - 1] - target);
+
+	if (!result.isReachable)
+	{
+		// Out of reach: the best pose is the chain straightened toward the target
+		Vector3 direction = Normalize(target - root);
+		for (int i = 1; i < count; i++)
+		{
+			solved[i] = solved[i - 1] + direction * chain.lengths[i - 1];
+		}
+		result.iterations = 1;
+	}
+
+	while (result.isReachable && result.iterations < settings.maxIterations && result.error > settings.tolerance)
+	{
+		// Backward pass pins the end effector on the target, forward pass pins the root back
+		solved[count - 1] = target;
+		for (int i = count - 2; i >= 0; i--)
+		{
+			solved[i] = solved[i + 1] + Normalize(solved[i] - solved[i + 1]) * chain.lengths[i];
+		}
+
+		solved[0] = root;
+		for (int i = 1; i < count; i++)
+		{
+			solved[i] = solved[i - 1] + Normalize(solved[i] - solved[i - 1]) * chain.lengths[i - 1];
+		}
+
+		result.iterations++;
+		result.error = Length(solved[count - 1] - target);
+	}
+
+	// Root first, turn each bone so its child lands on the solved position
+	for (int i = 0; i < count - 1; i++)
+	{
+		RotateChain(chain, i, FromToRotation(chain.positions[i + 1] - chain.positions[i], solved[i + 1] - chain.positions[i]));
+	}
+
+	result.error = Length(chain.positions[count - 1] - target);
+	EndChainSolve(skeleton, chain, parentRotation);
+	ANIMATION_PROFILE_COUNT(CounterIKIterations, result.iterations);
+	ANIMATION_PROFILE_COUNT(CounterIKUnreachable, result.isReachable ? 0 : 1);
+	return result;
+}
+
+IKIterativeResult SolveCCD(Skeleton& skeleton, IKBoneChain& chain, const Vector3& target, const IKIterativeSettings& settings)
+{
+	ANIMATION_PROFILE_SCOPE(ProfileIK);
+	IKIterativeResult result = IKIterativeResult();
+	int count = chain.bones.size();
+	if (count < 2)
+	{
+		return result;
+	}
+
+	Quaternion parentRotation = BeginChainSolve(skeleton, chain, settings.warmStart);
+
+	result.isReachable = Length(target - chain.positions[0]) <= GetChainLength(chain);
+	result.error = Length(chain.positions[count - 1] - target);
+
+	while (result.iterations < settings.maxIterations && result.error > settings.tolerance)
+	{
+		// From the end effector's parent up to the root, aim the end effector at the target
+		for (int joint = count - 2; joint >= 0; joint--)
+		{
+			Vector3 pivot = chain.positions[joint];
+			RotateChain(chain, joint, FromToRotation(chain.positions[count - 1] - pivot, target - pivot));
+		}
+
+		result.iterations++;
+		result.error = Length(chain.positions[count - 1] - target);
+	}
+
+	EndChainSolve(skeleton, chain, parentRotation);
+	ANIMATION_PROFILE_COUNT(CounterIKIterations, result.iterations);
+	ANIMATION_PROFILE_COUNT(CounterIKUnreachable, result.isReachable ? 0 : 1);
+	return result;
+}
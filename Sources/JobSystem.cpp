@@ -0,0 +1,179 @@
+#include "../Headers/JobSystem.h"
+
+// Queue owned by the current thread, so nested ParallelFor calls push to the right deque
+struct JobThreadContext
+{
+    const void* owner;
+    int queueIndex;
+};
+
+static thread_local JobThreadContext currentJobThread = { nullptr, -1 };
+
+JobSystem::JobSystem(int workerCount) : pendingTasks(0), stopping(false), nextQueue(0)
+{
+    if (workerCount <= 0)
+    {
+        int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    queues = std::vector<WorkerQueue>(workerCount + 1);
+
+    for (int i = 0; i < workerCount; i++)
+    {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+
+    wakeCondition.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+int JobSystem::GetThreadCount() const
+{
+    return workers.size() + 1;
+}
+
+void JobSystem::ParallelFor(int count, int grainSize, const std::function<void(int begin, int end)>& body)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    if (grainSize < 1)
+    {
+        grainSize = 1;
+    }
+
+    // Single chunk: no point going through the queues
+    if (count <= grainSize)
+    {
+        body(0, count);
+        return;
+    }
+
+    int queueIndex = currentJobThread.owner == this ? currentJobThread.queueIndex : (int)workers.size();
+    int chunkCount = (count + grainSize - 1) / grainSize;
+    std::atomic<int> remaining(chunkCount);
+
+    pendingTasks += chunkCount;
+
+    {
+        WorkerQueue& queue = queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        // Pushed in reverse so the owner pops chunks in ascending order while thieves take the far end
+        for (int chunk = chunkCount - 1; chunk >= 0; chunk--)
+        {
+            int begin = chunk * grainSize;
+            int end = begin + grainSize < count ? begin + grainSize : count;
+            queue.tasks.push_back({ &body, begin, end, &remaining });
+        }
+    }
+
+    {
+        // Taking the lock orders the wake-up after any worker's predicate check
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+
+    wakeCondition.notify_all();
+
+    // Help until every chunk of this loop has completed
+    while (remaining.load(std::memory_order_acquire) > 0)
+    {
+        if (!TryRunTask(queueIndex))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::WorkerLoop(int workerIndex)
+{
+    currentJobThread = { this, workerIndex };
+
+    while (true)
+    {
+        if (TryRunTask(workerIndex))
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this] { return stopping.load() || pendingTasks.load() > 0; });
+
+        if (stopping)
+        {
+            return;
+        }
+    }
+}
+
+bool JobSystem::TryRunTask(int queueIndex)
+{
+    Task task;
+
+    if (!PopTask(queueIndex, task) && !StealTask(queueIndex, task))
+    {
+        return false;
+    }
+
+    pendingTasks--;
+    (*task.body)(task.begin, task.end);
+    task.remaining->fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+bool JobSystem::PopTask(int queueIndex, Task& outTask)
+{
+    WorkerQueue& queue = queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+
+    outTask = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool JobSystem::StealTask(int thiefIndex, Task& outTask)
+{
+    int queueCount = queues.size();
+    int start = nextQueue.fetch_add(1, std::memory_order_relaxed) % queueCount;
+
+    for (int i = 0; i < queueCount; i++)
+    {
+        int victim = (start + i) % queueCount;
+        if (victim == thiefIndex)
+        {
+            continue;
+        }
+
+        WorkerQueue& queue = queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.tasks.empty())
+        {
+            outTask = queue.tasks.front();
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -1,5 +1,18 @@
 #include "../Headers/MathsUtils.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ANIMATION_SIMD_SSE 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ANIMATION_TARGET_AVX
+#else
+#define ANIMATION_TARGET_AVX __attribute__((target("avx")))
+#endif
+#else
+#define ANIMATION_SIMD_SSE 0
+#endif
+
 Matrix4x4::Matrix4x4()
 {
     for (int i = 0; i < 16; i++)
@@ -25,9 +38,9 @@ Matrix4x4 Matrix4x4::RotationZ(float angleRadians)
     return result;
 }
 
-Matrix4x4 Matrix4x4::operator*(const Matrix4x4& other) const
+static void MultiplyMatrixScalar(const Matrix4x4& a, const Matrix4x4& b, Matrix4x4& result)
 {
-    Matrix4x4 result;
+    float temp[16];
 
     for (int row = 0; row < 4; row++)
     {
@@ -37,16 +50,144 @@ Matrix4x4 Matrix4x4::operator*(const Matrix4x4& other) const
 
             for (int k = 0; k < 4; k++)
             {
-                sum += this->data[row * 4 + k] * other.data[k * 4 + col];
+                sum += a.data[row * 4 + k] * b.data[k * 4 + col];
             }
 
-            result.data[row * 4 + col] = sum;
+            temp[row * 4 + col] = sum;
         }
     }
 
+    for (int i = 0; i < 16; i++)
+    {
+        result.data[i] = temp[i];
+    }
+}
+
+#if ANIMATION_SIMD_SSE
+// Each result row is a linear combination of the rows of b, accumulated in the same order as the scalar loop
+static inline __m128 CombineRows(__m128 aRow, __m128 b0, __m128 b1, __m128 b2, __m128 b3)
+{
+    __m128 sum = _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(aRow, aRow, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+    return sum;
+}
+
+static inline void MultiplyMatrixSSE(const Matrix4x4& a, const Matrix4x4& b, Matrix4x4& result)
+{
+    __m128 b0 = _mm_load_ps(&b.data[0]);
+    __m128 b1 = _mm_load_ps(&b.data[4]);
+    __m128 b2 = _mm_load_ps(&b.data[8]);
+    __m128 b3 = _mm_load_ps(&b.data[12]);
+
+    __m128 r0 = CombineRows(_mm_load_ps(&a.data[0]), b0, b1, b2, b3);
+    __m128 r1 = CombineRows(_mm_load_ps(&a.data[4]), b0, b1, b2, b3);
+    __m128 r2 = CombineRows(_mm_load_ps(&a.data[8]), b0, b1, b2, b3);
+    __m128 r3 = CombineRows(_mm_load_ps(&a.data[12]), b0, b1, b2, b3);
+
+    // Store last so result may alias a or b
+    _mm_store_ps(&result.data[0], r0);
+    _mm_store_ps(&result.data[4], r1);
+    _mm_store_ps(&result.data[8], r2);
+    _mm_store_ps(&result.data[12], r3);
+}
+
+static void MultiplyMatricesSSE(const Matrix4x4* parents, const Matrix4x4* locals, Matrix4x4* results, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        MultiplyMatrixSSE(parents[i], locals[i], results[i]);
+    }
+}
+
+// Two result rows per 256-bit register (unaligned access, Matrix4x4 is only 16-byte aligned). No FMA, so results are bit-identical to the SSE and scalar paths.
+ANIMATION_TARGET_AVX static void MultiplyMatricesAVX(const Matrix4x4* parents, const Matrix4x4* locals, Matrix4x4* results, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const float* a = parents[i].data;
+        const float* b = locals[i].data;
+
+        __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b[0]));
+        __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b[4]));
+        __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b[8]));
+        __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&b[12]));
+
+        __m256 a01 = _mm256_loadu_ps(&a[0]);
+        __m256 a23 = _mm256_loadu_ps(&a[8]);
+
+        __m256 r01 = _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_shuffle_ps(a01, a01, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+
+        __m256 r23 = _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_shuffle_ps(a23, a23, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+
+        _mm256_storeu_ps(&results[i].data[0], r01);
+        _mm256_storeu_ps(&results[i].data[8], r23);
+    }
+}
+
+static bool CpuSupportsAVX()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    return osSavesYmm && (info[2] & (1 << 28)) != 0;
+#else
+    return __builtin_cpu_supports("avx");
+#endif
+}
+#endif
+
+Matrix4x4 Matrix4x4::operator*(const Matrix4x4& other) const
+{
+    Matrix4x4 result;
+
+#if ANIMATION_SIMD_SSE
+    MultiplyMatrixSSE(*this, other, result);
+#else
+    MultiplyMatrixScalar(*this, other, result);
+#endif
+
     return result;
 }
 
+void MultiplyMatricesScalar(const Matrix4x4* parents, const Matrix4x4* locals, Matrix4x4* results, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        MultiplyMatrixScalar(parents[i], locals[i], results[i]);
+    }
+}
+
+typedef void (*MultiplyMatricesFunction)(const Matrix4x4*, const Matrix4x4*, Matrix4x4*, int);
+
+static MultiplyMatricesFunction SelectMultiplyMatrices()
+{
+#if ANIMATION_SIMD_SSE
+    if (CpuSupportsAVX())
+    {
+        return MultiplyMatricesAVX;
+    }
+
+    return MultiplyMatricesSSE;
+#else
+    return MultiplyMatricesScalar;
+#endif
+}
+
+void MultiplyMatrices(const Matrix4x4* parents, const Matrix4x4* locals, Matrix4x4* results, int count)
+{
+    static const MultiplyMatricesFunction multiply = SelectMultiplyMatrices();
+    multiply(parents, locals, results, count);
+}
+
 // Vector3 implementation
 Vector3::Vector3() : x(0), y(0), z(0) {}
 Vector3::Vector3(float _x, float _y, float _z) : x(_x), y(_y), z(_z) {}
@@ -85,6 +226,28 @@ Quaternion Quaternion::operator*(float scalar) const
     return Quaternion(x * scalar, y * scalar, z * scalar, w * scalar);
 }
 
+Quaternion Quaternion::operator*(const Quaternion& other) const
+{
+    return Quaternion(
+        w * other.x + x * other.w + y * other.z - z * other.y,
+        w * other.y - x * other.z + y * other.w + z * other.x,
+        w * other.z + x * other.y - y * other.x + z * other.w,
+        w * other.w - x * other.x - y * other.y - z * other.z
+    );
+}
+
+Quaternion Quaternion::FromAxisAngle(const Vector3& axis, float angleRadians)
+{
+    float length = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+    if (length == 0.0f)
+    {
+        return Quaternion();
+    }
+
+    float s = std::sin(angleRadians * 0.5f) / length;
+    return Quaternion(axis.x * s, axis.y * s, axis.z * s, std::cos(angleRadians * 0.5f));
+}
+
 // Transform implementation
 Transform::Transform() : position(0, 0, 0), rotation(0, 0, 0, 1), scale(1, 1, 1) {}
 
@@ -120,6 +283,170 @@ Transform Transform::operator*(float scalar) const
     );
 }
 
+// Matrix3x4 implementation
+Matrix3x4::Matrix3x4()
+{
+    for (int i = 0; i < 12; i++)
+    {
+        data[i] = 0;
+    }
+
+    data[0] = 1;
+    data[5] = 1;
+    data[10] = 1;
+}
+
+// Transform composition
+float Dot(const Vector3& a, const Vector3& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+Vector3 Cross(const Vector3& a, const Vector3& b)
+{
+    return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+}
+
+float Length(const Vector3& vector)
+{
+    return std::sqrt(Dot(vector, vector));
+}
+
+Vector3 Normalize(const Vector3& vector)
+{
+    float length = Length(vector);
+    if (length == 0.0f)
+    {
+        return Vector3();
+    }
+
+    return vector * (1.0f / length);
+}
+
+Vector3 Rotate(const Quaternion& rotation, const Vector3& vector)
+{
+    // v' = v + w * t + q.xyz x t, with t = 2 * (q.xyz x v)
+    float tx = 2.0f * (rotation.y * vector.z - rotation.z * vector.y);
+    float ty = 2.0f * (rotation.z * vector.x - rotation.x * vector.z);
+    float tz = 2.0f * (rotation.x * vector.y - rotation.y * vector.x);
+
+    return Vector3(
+        vector.x + rotation.w * tx + (rotation.y * tz - rotation.z * ty),
+        vector.y + rotation.w * ty + (rotation.z * tx - rotation.x * tz),
+        vector.z + rotation.w * tz + (rotation.x * ty - rotation.y * tx)
+    );
+}
+
+Transform Combine(const Transform& parent, const Transform& local)
+{
+    Vector3 scaledPosition(local.position.x * parent.scale.x, local.position.y * parent.scale.y, local.position.z * parent.scale.z);
+
+    return Transform(
+        parent.position + Rotate(parent.rotation, scaledPosition),
+        parent.rotation * local.rotation,
+        Vector3(parent.scale.x * local.scale.x, parent.scale.y * local.scale.y, parent.scale.z * local.scale.z)
+    );
+}
+
+Transform Inverse(const Transform& transform)
+{
+    Quaternion rotation = Conjugate(transform.rotation);
+    Vector3 scale(1.0f / transform.scale.x, 1.0f / transform.scale.y, 1.0f / transform.scale.z);
+    Vector3 position = Rotate(rotation, transform.position * -1.0f);
+
+    return Transform(Vector3(position.x * scale.x, position.y * scale.y, position.z * scale.z), rotation, scale);
+}
+
+Matrix3x4 ToMatrix3x4(const Transform& transform)
+{
+    const Quaternion& q = transform.rotation;
+    const Vector3& s = transform.scale;
+
+    Matrix3x4 result;
+
+    result.data[0] = (1.0f - 2.0f * (q.y * q.y + q.z * q.z)) * s.x;
+    result.data[1] = 2.0f * (q.x * q.y - q.w * q.z) * s.y;
+    result.data[2] = 2.0f * (q.x * q.z + q.w * q.y) * s.z;
+    result.data[3] = transform.position.x;
+
+    result.data[4] = 2.0f * (q.x * q.y + q.w * q.z) * s.x;
+    result.data[5] = (1.0f - 2.0f * (q.x * q.x + q.z * q.z)) * s.y;
+    result.data[6] = 2.0f * (q.y * q.z - q.w * q.x) * s.z;
+    result.data[7] = transform.position.y;
+
+    result.data[8] = 2.0f * (q.x * q.z - q.w * q.y) * s.x;
+    result.data[9] = 2.0f * (q.y * q.z + q.w * q.x) * s.y;
+    result.data[10] = (1.0f - 2.0f * (q.x * q.x + q.y * q.y)) * s.z;
+    result.data[11] = transform.position.z;
+
+    return result;
+}
+
+Matrix4x4 ToMatrix4x4(const Transform& transform)
+{
+    Matrix3x4 affine = ToMatrix3x4(transform);
+    Matrix4x4 result = Matrix4x4();
+
+    for (int i = 0; i < 12; i++)
+    {
+        result.data[i] = affine.data[i];
+    }
+
+    return result;
+}
+
+Transform ToTransform(const Matrix4x4& matrix)
+{
+    const float* m = matrix.data;
+
+    Vector3 scale(
+        std::sqrt(m[0] * m[0] + m[4] * m[4] + m[8] * m[8]),
+        std::sqrt(m[1] * m[1] + m[5] * m[5] + m[9] * m[9]),
+        std::sqrt(m[2] * m[2] + m[6] * m[6] + m[10] * m[10])
+    );
+
+    // A mirroring matrix keeps a proper rotation and carries the reflection as a negative X scale
+    float determinant = m[0] * (m[5] * m[10] - m[6] * m[9]) - m[1] * (m[4] * m[10] - m[6] * m[8]) + m[2] * (m[4] * m[9] - m[5] * m[8]);
+    if (determinant < 0.0f)
+    {
+        scale.x = -scale.x;
+    }
+
+    float invX = scale.x != 0.0f ? 1.0f / scale.x : 0.0f;
+    float invY = scale.y > 0.0f ? 1.0f / scale.y : 0.0f;
+    float invZ = scale.z > 0.0f ? 1.0f / scale.z : 0.0f;
+
+    float m00 = m[0] * invX, m01 = m[1] * invY, m02 = m[2] * invZ;
+    float m10 = m[4] * invX, m11 = m[5] * invY, m12 = m[6] * invZ;
+    float m20 = m[8] * invX, m21 = m[9] * invY, m22 = m[10] * invZ;
+
+    Quaternion rotation;
+    float trace = m00 + m11 + m22;
+
+    if (trace > 0.0f)
+    {
+        float s = std::sqrt(trace + 1.0f) * 2.0f;
+        rotation = Quaternion((m21 - m12) / s, (m02 - m20) / s, (m10 - m01) / s, 0.25f * s);
+    }
+    else if (m00 > m11 && m00 > m22)
+    {
+        float s = std::sqrt(1.0f + m00 - m11 - m22) * 2.0f;
+        rotation = Quaternion(0.25f * s, (m01 + m10) / s, (m02 + m20) / s, (m21 - m12) / s);
+    }
+    else if (m11 > m22)
+    {
+        float s = std::sqrt(1.0f + m11 - m00 - m22) * 2.0f;
+        rotation = Quaternion((m01 + m10) / s, 0.25f * s, (m12 + m21) / s, (m02 - m20) / s);
+    }
+    else
+    {
+        float s = std::sqrt(1.0f + m22 - m00 - m11) * 2.0f;
+        rotation = Quaternion((m02 + m20) / s, (m12 + m21) / s, 0.25f * s, (m10 - m01) / s);
+    }
+
+    return Transform(Vector3(m[3], m[7], m[11]), Normalize(rotation), scale);
+}
+
 // Lerp functions
 float Lerp(float a, float b, float t)
 {
@@ -179,6 +506,155 @@ Transform Lerp(const Transform& a, const Transform& b, float t)
     return result;
 }
 
+// Rotation blending
+float Dot(const Quaternion& a, const Quaternion& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+Quaternion Normalize(const Quaternion& q)
+{
+    float lengthSquared = Dot(q, q);
+    if (lengthSquared == 0.0f)
+    {
+        return Quaternion();
+    }
+
+    return q * (1.0f / std::sqrt(lengthSquared));
+}
+
+Quaternion Conjugate(const Quaternion& q)
+{
+    return Quaternion(-q.x, -q.y, -q.z, q.w);
+}
+
+Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t)
+{
+    float sign = Dot(a, b) < 0.0f ? -1.0f : 1.0f;
+
+    return Normalize(Quaternion(
+        a.x + (b.x * sign - a.x) * t,
+        a.y + (b.y * sign - a.y) * t,
+        a.z + (b.z * sign - a.z) * t,
+        a.w + (b.w * sign - a.w) * t
+    ));
+}
+
+Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t)
+{
+    float cosTheta = Dot(a, b);
+    Quaternion target = b;
+
+    if (cosTheta < 0.0f)
+    {
+        cosTheta = -cosTheta;
+        target = b * -1.0f;
+    }
+
+    // Nearly parallel: sin(theta) vanishes, nlerp is exact enough
+    if (cosTheta > 0.9995f)
+    {
+        return Nlerp(a, target, t);
+    }
+
+    float theta = std::acos(cosTheta);
+    float sinTheta = std::sin(theta);
+    float weightA = std::sin((1.0f - t) * theta) / sinTheta;
+    float weightB = std::sin(t * theta) / sinTheta;
+
+    return a * weightA + target * weightB;
+}
+
+// Corrects t so that nlerp follows slerp's constant angular velocity (max error around 1e-3 rad)
+static inline float CorrectSlerpT(float d, float t)
+{
+    float A = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    float B = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    float k = A * (t - 0.5f) * (t - 0.5f) + B;
+    return t + t * (t - 0.5f) * (t - 1.0f) * k;
+}
+
+Quaternion SlerpApproximate(const Quaternion& a, const Quaternion& b, float t)
+{
+    float d = Dot(a, b);
+    return Nlerp(a, b, CorrectSlerpT(std::abs(d), t));
+}
+
+void SlerpBatch(const Quaternion* from, const Quaternion* to, float t, Quaternion* results, int count)
+{
+    int i = 0;
+
+#if ANIMATION_SIMD_SSE
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 vt = _mm_set1_ps(t);
+    const __m128 tHalf = _mm_set1_ps(t - 0.5f);
+    const __m128 tCurve = _mm_set1_ps(t * (t - 0.5f) * (t - 1.0f));
+
+    for (; i + 4 <= count; i += 4)
+    {
+        // Transpose 4 quaternions into x, y, z, w lanes
+        __m128 ax = _mm_loadu_ps(&from[i].x);
+        __m128 ay = _mm_loadu_ps(&from[i + 1].x);
+        __m128 az = _mm_loadu_ps(&from[i + 2].x);
+        __m128 aw = _mm_loadu_ps(&from[i + 3].x);
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+
+        __m128 bx = _mm_loadu_ps(&to[i].x);
+        __m128 by = _mm_loadu_ps(&to[i + 1].x);
+        __m128 bz = _mm_loadu_ps(&to[i + 2].x);
+        __m128 bw = _mm_loadu_ps(&to[i + 3].x);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+
+        // Hemisphere fix: flip b by the sign of the dot product
+        __m128 sign = _mm_and_ps(dot, signMask);
+        bx = _mm_xor_ps(bx, sign);
+        by = _mm_xor_ps(by, sign);
+        bz = _mm_xor_ps(bz, sign);
+        bw = _mm_xor_ps(bw, sign);
+        __m128 d = _mm_andnot_ps(signMask, dot);
+
+        __m128 A = _mm_add_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(-1.43519f)));
+        A = _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(d, A));
+        A = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d, A));
+        __m128 B = _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(d, _mm_set1_ps(0.215638f)));
+        B = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d, B));
+        __m128 k = _mm_add_ps(_mm_mul_ps(A, _mm_mul_ps(tHalf, tHalf)), B);
+        __m128 ot = _mm_add_ps(vt, _mm_mul_ps(tCurve, k));
+
+        __m128 rx = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(bx, ax), ot));
+        __m128 ry = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(by, ay), ot));
+        __m128 rz = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(bz, az), ot));
+        __m128 rw = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(bw, aw), ot));
+
+        // rsqrt plus one Newton-Raphson step
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)), _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+        __m128 inverseLength = _mm_rsqrt_ps(lengthSquared);
+        __m128 halfLengthSquared = _mm_mul_ps(lengthSquared, _mm_set1_ps(0.5f));
+        inverseLength = _mm_mul_ps(inverseLength, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfLengthSquared, _mm_mul_ps(inverseLength, inverseLength))));
+
+        // Zero-length lanes become the identity, like Normalize
+        __m128 isZero = _mm_cmpeq_ps(lengthSquared, _mm_setzero_ps());
+        rx = _mm_andnot_ps(isZero, _mm_mul_ps(rx, inverseLength));
+        ry = _mm_andnot_ps(isZero, _mm_mul_ps(ry, inverseLength));
+        rz = _mm_andnot_ps(isZero, _mm_mul_ps(rz, inverseLength));
+        rw = _mm_or_ps(_mm_andnot_ps(isZero, _mm_mul_ps(rw, inverseLength)), _mm_and_ps(isZero, _mm_set1_ps(1.0f)));
+
+        _MM_TRANSPOSE4_PS(rx, ry, rz, rw);
+        _mm_storeu_ps(&results[i].x, rx);
+        _mm_storeu_ps(&results[i + 1].x, ry);
+        _mm_storeu_ps(&results[i + 2].x, rz);
+        _mm_storeu_ps(&results[i + 3].x, rw);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        results[i] = SlerpApproximate(from[i], to[i], t);
+    }
+}
+
 float Clamp(float value, float min, float max)
 {
     if (value < min)
@@ -0,0 +1,51 @@
+#include "../Headers/RootMotion.h"
+
+static const float Pi = 3.14159265f;
+
+RootMotion::RootMotion() : translation(), yaw(0.0f) {}
+
+RootMotion::RootMotion(const Vector3& _translation, float _yaw) : translation(_translation), yaw(_yaw) {}
+
+RootMotion RootMotion::operator+(const RootMotion& other) const
+{
+    return RootMotion(translation + other.translation, yaw + other.yaw);
+}
+
+RootMotion RootMotion::operator*(float scalar) const
+{
+    return RootMotion(translation * scalar, yaw * scalar);
+}
+
+Vector3 RotateYaw(float yaw, const Vector3& vector)
+{
+    float c = std::cos(yaw);
+    float s = std::sin(yaw);
+    return Vector3(vector.x * c + vector.z * s, vector.y, vector.z * c - vector.x * s);
+}
+
+RootMotion Combine(const RootMotion& first, const RootMotion& second)
+{
+    return RootMotion(first.translation + RotateYaw(first.yaw, second.translation), first.yaw + second.yaw);
+}
+
+RootMotion Inverse(const RootMotion& motion)
+{
+    return RootMotion(RotateYaw(-motion.yaw, motion.translation * -1.0f), -motion.yaw);
+}
+
+float GetYaw(const Quaternion& rotation)
+{
+    Vector3 forward = Rotate(rotation, Vector3(0.0f, 0.0f, 1.0f));
+    return std::atan2(forward.x, forward.z);
+}
+
+void RootMotionAccumulator::Apply(const RootMotion& delta)
+{
+    position = position + RotateYaw(yaw, delta.translation);
+    yaw = std::remainder(yaw + delta.yaw, 2.0f * Pi);
+}
+
+Transform RootMotionAccumulator::GetTransform() const
+{
+    return Transform(position, Quaternion::FromAxisAngle(Vector3(0.0f, 1.0f, 0.0f), yaw), Vector3(1.0f, 1.0f, 1.0f));
+}
@@ -17,44 +17,69 @@ int Skeleton::AddBone(const std::string& name, int parentIndex, const Matrix4x4&
 {
     bonesName.push_back(name);
     bonesParentIndex.push_back(parentIndex);
-    bonesLocalTransform.push_back(localTransform);
+    bonesLocalPose.push_back(ToTransform(localTransform));
+    bonesDirty.push_back(1);
+    updateOrderDirty = true;
+    InsertBoneHash(bonesName.size() - 1);
     return bonesName.size() - 1;
 }
 
-int Skeleton::FindBone(const std::string& name)
+int Skeleton::AddBone(const std::string& name, int parentIndex, const Transform& localTransform)
 {
-    if (name.empty())
+    bonesName.push_back(name);
+    bonesParentIndex.push_back(parentIndex);
+    bonesLocalPose.push_back(localTransform);
+    bonesDirty.push_back(1);
+    updateOrderDirty = true;
+    InsertBoneHash(bonesName.size() - 1);
+    return bonesName.size() - 1;
+}
+
+int Skeleton::FindBone(std::string_view name) const
+{
+    if (name.empty() || boneIndexSlots.empty())
     {
         return -1;
     }
 
-    for (int i = 0; i <= bonesName.size() - 1; i++)
+    uint32_t hash = HashBoneName(name);
+    uint32_t mask = boneIndexSlots.size() - 1;
+
+    for (uint32_t slot = hash & mask; boneIndexSlots[slot] >= 0; slot = (slot + 1) & mask)
     {
-        if (bonesName[i] == name)
+        if (boneHashSlots[slot] == hash && bonesName[boneIndexSlots[slot]] == name)
         {
-            return i;
+            return boneIndexSlots[slot];
         }
     }
 
     return -1;
 }
 
-void Skeleton::UpdateWorldTransforms()
+int Skeleton::FindBone(BoneId id) const
 {
-    bonesWorldTransform.resize(bonesName.size());
+    if (boneIndexSlots.empty())
+    {
+        return -1;
+    }
 
-    for (int i = 0; i < bonesName.size(); i++)
+    uint32_t mask = boneIndexSlots.size() - 1;
+
+    for (uint32_t slot = id.hash & mask; boneIndexSlots[slot] >= 0; slot = (slot + 1) & mask)
     {
-        if (i == 0)
+        if (boneHashSlots[slot] == id.hash)
         {
-            bonesWorldTransform[i] = bonesLocalTransform[i];
-            continue;
+            return boneIndexSlots[slot];
         }
-
-        Matrix4x4 ParentWorldTransform = GetWorldTransform(bonesParentIndex[i]);
-        Matrix4x4 WorldTransform = ParentWorldTransform * bonesLocalTransform[i];
-        bonesWorldTransform[i] = WorldTransform;
     }
+
+    return -1;
+}
+
+// Matrix API kept for existing callers: the TRS poses are the only stored state
+void Skeleton::UpdateWorldTransforms()
+{
+    UpdateWorldPoses();
 }
 
 Matrix4x4 Skeleton::GetWorldTransform(int boneIndex)
@@ -64,7 +89,7 @@ Matrix4x4 Skeleton::GetWorldTransform(int boneIndex)
         return Matrix4x4();
     }
 
-    return bonesWorldTransform[boneIndex];
+    return boneIndex < bonesWorldPose.size() ? ToMatrix4x4(bonesWorldPose[boneIndex]) : Matrix4x4();
 }
 
 void Skeleton::SetLocalTransform(int boneIndex, const Matrix4x4& newTransform)
@@ -74,7 +99,152 @@ void Skeleton::SetLocalTransform(int boneIndex, const Matrix4x4& newTransform)
         return;
     }
 
-    bonesLocalTransform[boneIndex] = newTransform;
+    bonesLocalPose[boneIndex] = ToTransform(newTransform);
+    MarkDirty(boneIndex);
+}
+
+void Skeleton::SetLocalTransform(int boneIndex, const Transform& newTransform)
+{
+    if (boneIndex < 0 || boneIndex >= bonesName.size())
+    {
+        return;
+    }
+
+    bonesLocalPose[boneIndex] = newTransform;
+    MarkDirty(boneIndex);
+}
+
+void Skeleton::UpdateWorldPoses()
+{
+    RebuildUpdateOrder();
+    bonesWorldPose.resize(bonesName.size());
+    lastUpdatedBoneCount = 0;
+
+    int position = 0;
+    while (position < bonesUpdateOrder.size())
+    {
+        if (!bonesDirty[bonesUpdateOrder[position]])
+        {
+            position++;
+            continue;
+        }
+
+        // A dirty bone invalidates its whole subtree, which is contiguous in update order
+        int subtreeEnd = bonesSubtreeEnd[position];
+        for (int i = position; i < subtreeEnd; i++)
+        {
+            int bone = bonesUpdateOrder[i];
+            int parentIndex = bonesUpdateParent[bone];
+
+            if (parentIndex < 0)
+            {
+                bonesWorldPose[bone] = bonesLocalPose[bone];
+            }
+            else
+            {
+                bonesWorldPose[bone] = Combine(bonesWorldPose[parentIndex], bonesLocalPose[bone]);
+            }
+
+            bonesDirty[bone] = 0;
+        }
+
+        lastUpdatedBoneCount += subtreeEnd - position;
+        position = subtreeEnd;
+    }
+}
+
+void Skeleton::SplitWorldPoseUpdate(int maxSpanBones, std::vector<int>& outSerialBones, std::vector<BoneSpan>& outSpans)
+{
+    RebuildUpdateOrder();
+    bonesWorldPose.resize(bonesName.size());
+
+    outSerialBones.clear();
+    outSpans.clear();
+
+    // A subtree small enough becomes one span; otherwise its root is updated serially and its children are split further
+    int position = 0;
+    while (position < bonesUpdateOrder.size())
+    {
+        int subtreeEnd = bonesSubtreeEnd[position];
+
+        if (subtreeEnd - position <= maxSpanBones)
+        {
+            outSpans.push_back({ position, subtreeEnd });
+            position = subtreeEnd;
+            continue;
+        }
+
+        outSerialBones.push_back(bonesUpdateOrder[position]);
+        position++;
+    }
+}
+
+void Skeleton::GetRequiredBones(const int* bones, int count, std::vector<int>& outBones)
+{
+    RebuildUpdateOrder();
+    bonesWorldPose.resize(bonesName.size());
+    outBones.clear();
+
+    // Walk up from each bone until reaching one already in the set
+    std::vector<unsigned char> required(bonesName.size(), 0);
+    for (int i = 0; i < count; i++)
+    {
+        for (int bone = bones[i]; bone >= 0 && bone < required.size() && !required[bone]; bone = bonesUpdateParent[bone])
+        {
+            required[bone] = 1;
+        }
+    }
+
+    for (int bone : bonesUpdateOrder)
+    {
+        if (required[bone])
+        {
+            outBones.push_back(bone);
+        }
+    }
+}
+
+// A recomputed bone hands its change down to its children, so children left out of the list stay dirty for a later update
+void Skeleton::UpdateWorldPoses(const int* bones, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        int bone = bones[i];
+        if (!bonesDirty[bone])
+        {
+            continue;
+        }
+
+        int parentIndex = bonesUpdateParent[bone];
+        bonesWorldPose[bone] = parentIndex < 0 ? bonesLocalPose[bone] : Combine(bonesWorldPose[parentIndex], bonesLocalPose[bone]);
+        bonesDirty[bone] = 0;
+        MarkChildrenDirty(bonesUpdatePosition[bone]);
+    }
+}
+
+void Skeleton::UpdateWorldPoses(const BoneSpan& span)
+{
+    UpdateWorldPoses(&bonesUpdateOrder[span.begin], span.end - span.begin);
+}
+
+Transform Skeleton::GetWorldPose(int boneIndex)
+{
+    if (boneIndex < 0 || boneIndex >= bonesWorldPose.size())
+    {
+        return Transform();
+    }
+
+    return bonesWorldPose[boneIndex];
+}
+
+void Skeleton::GetSkinningMatrices(std::vector<Matrix3x4>& outMatrices)
+{
+    outMatrices.resize(bonesWorldPose.size());
+
+    for (int i = 0; i < bonesWorldPose.size(); i++)
+    {
+        outMatrices[i] = ToMatrix3x4(bonesWorldPose[i]);
+    }
 }
 
 void Skeleton::ShowBonesTransform()
@@ -90,8 +260,180 @@ void Skeleton::ShowBonesTransform()
     {
         std::cout << bonesName[i] << std::endl;
         std::cout << "[" << std::endl;
-        bonesWorldTransform[i].Print();
+        GetWorldTransform(i).Print();
         std::cout << "]" << std::endl;
         std::cout << std::endl;
     }
 }
+
+int Skeleton::GetBoneCount() const
+{
+    return bonesName.size();
+}
+
+const std::string& Skeleton::GetBoneName(int boneIndex) const
+{
+    static const std::string EmptyName;
+
+    if (boneIndex < 0 || boneIndex >= bonesName.size())
+    {
+        return EmptyName;
+    }
+
+    return bonesName[boneIndex];
+}
+
+int Skeleton::GetParentIndex(int boneIndex) const
+{
+    if (boneIndex < 0 || boneIndex >= bonesName.size())
+    {
+        return -1;
+    }
+
+    return bonesParentIndex[boneIndex];
+}
+
+int Skeleton::GetUpdateParent(int boneIndex) const
+{
+    int parentIndex = GetParentIndex(boneIndex);
+    if (boneIndex == 0 || parentIndex < 0 || parentIndex >= bonesName.size() || parentIndex == boneIndex)
+    {
+        return -1;
+    }
+
+    return parentIndex;
+}
+
+Matrix4x4 Skeleton::GetLocalTransform(int boneIndex) const
+{
+    if (boneIndex < 0 || boneIndex >= bonesName.size())
+    {
+        return Matrix4x4();
+    }
+
+    return ToMatrix4x4(bonesLocalPose[boneIndex]);
+}
+
+Transform Skeleton::GetLocalPose(int boneIndex) const
+{
+    if (boneIndex < 0 || boneIndex >= bonesName.size())
+    {
+        return Transform();
+    }
+
+    return bonesLocalPose[boneIndex];
+}
+
+int Skeleton::GetLastUpdatedBoneCount() const
+{
+    return lastUpdatedBoneCount;
+}
+
+void Skeleton::MarkDirty(int boneIndex)
+{
+    bonesDirty[boneIndex] = 1;
+}
+
+// The children of the bone at an update position follow it, each one followed by its own subtree
+void Skeleton::MarkChildrenDirty(int position)
+{
+    for (int child = position + 1; child < bonesSubtreeEnd[position]; child = bonesSubtreeEnd[child])
+    {
+        bonesDirty[bonesUpdateOrder[child]] = 1;
+    }
+}
+
+void Skeleton::InsertBoneHash(int boneIndex)
+{
+    const std::string& name = bonesName[boneIndex];
+
+    // Empty names are never looked up; duplicates keep the first bone, like the linear search did
+    if (name.empty() || FindBone(std::string_view(name)) >= 0)
+    {
+        return;
+    }
+
+    // Grow and rehash to keep the table at most half full
+    if ((boneIndex + 1) * 2 > boneIndexSlots.size())
+    {
+        int newSize = boneIndexSlots.empty() ? 16 : boneIndexSlots.size() * 2;
+        boneHashSlots.assign(newSize, 0);
+        boneIndexSlots.assign(newSize, -1);
+
+        for (int i = 0; i < boneIndex; i++)
+        {
+            InsertBoneHash(i);
+        }
+    }
+
+    uint32_t hash = HashBoneName(name);
+    uint32_t mask = boneIndexSlots.size() - 1;
+    uint32_t slot = hash & mask;
+
+    while (boneIndexSlots[slot] >= 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    boneHashSlots[slot] = hash;
+    boneIndexSlots[slot] = boneIndex;
+}
+
+void Skeleton::RebuildUpdateOrder()
+{
+    if (!updateOrderDirty)
+    {
+        return;
+    }
+
+    int boneCount = bonesName.size();
+
+    bonesUpdateParent.resize(boneCount);
+    std::vector<std::vector<int>> children(boneCount);
+    for (int i = 0; i < boneCount; i++)
+    {
+        bonesUpdateParent[i] = GetUpdateParent(i);
+        if (bonesUpdateParent[i] >= 0)
+        {
+            children[bonesUpdateParent[i]].push_back(i);
+        }
+    }
+
+    bonesUpdateOrder.clear();
+    bonesSubtreeEnd.assign(boneCount, 0);
+    bonesUpdatePosition.assign(boneCount, -1);
+    std::vector<int> stack;
+
+    for (int root = 0; root < boneCount; root++)
+    {
+        if (bonesUpdateParent[root] >= 0)
+        {
+            continue;
+        }
+
+        // Iterative depth-first walk; a negative entry closes the subtree of bone (-entry - 1)
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            int entry = stack.back();
+            stack.pop_back();
+
+            if (entry < 0)
+            {
+                bonesSubtreeEnd[bonesUpdatePosition[-entry - 1]] = bonesUpdateOrder.size();
+                continue;
+            }
+
+            bonesUpdatePosition[entry] = bonesUpdateOrder.size();
+            bonesUpdateOrder.push_back(entry);
+            stack.push_back(-entry - 1);
+
+            for (int c = children[entry].size() - 1; c >= 0; c--)
+            {
+                stack.push_back(children[entry][c]);
+            }
+        }
+    }
+
+    updateOrderDirty = false;
+}
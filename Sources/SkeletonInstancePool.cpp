@@ -0,0 +1,129 @@
+#include "../Headers/SkeletonInstancePool.h"
+
+#include <algorithm>
+
+SkeletonInstancePool::SkeletonInstancePool(const Skeleton& skeleton, int instanceCount) : boneCount(skeleton.GetBoneCount()), instanceCount(0)
+{
+    // Sort bones by depth so every parent is computed before its children
+    std::vector<int> depths(boneCount, 0);
+    for (int i = 0; i < boneCount; i++)
+    {
+        int parent = skeleton.GetParentIndex(i);
+        while (parent >= 0 && parent < boneCount && depths[i] < boneCount)
+        {
+            depths[i]++;
+            parent = skeleton.GetParentIndex(parent);
+        }
+    }
+
+    std::vector<int> sortedToBoneIndex(boneCount);
+    for (int i = 0; i < boneCount; i++)
+    {
+        sortedToBoneIndex[i] = i;
+    }
+
+    std::stable_sort(sortedToBoneIndex.begin(), sortedToBoneIndex.end(), [&depths](int a, int b) { return depths[a] < depths[b]; });
+
+    boneToSortedIndex.resize(boneCount);
+    for (int i = 0; i < boneCount; i++)
+    {
+        boneToSortedIndex[sortedToBoneIndex[i]] = i;
+    }
+
+    sortedParentIndex.resize(boneCount);
+    bindLocalTransform.resize(boneCount);
+    for (int i = 0; i < boneCount; i++)
+    {
+        int boneIndex = sortedToBoneIndex[i];
+        int parent = skeleton.GetParentIndex(boneIndex);
+
+        sortedParentIndex[i] = (parent >= 0 && parent < boneCount && parent != boneIndex) ? boneToSortedIndex[parent] : -1;
+        bindLocalTransform[i] = skeleton.GetLocalTransform(boneIndex);
+    }
+
+    SetInstanceCount(instanceCount);
+}
+
+void SkeletonInstancePool::SetInstanceCount(int newInstanceCount)
+{
+    if (newInstanceCount < 0 || newInstanceCount == instanceCount)
+    {
+        return;
+    }
+
+    // Re-stride the bone-major layout, keeping existing instances and filling new ones with the bind pose
+    std::vector<Matrix4x4> newLocalTransforms(boneCount * newInstanceCount);
+    int keptInstances = std::min(instanceCount, newInstanceCount);
+
+    for (int bone = 0; bone < boneCount; bone++)
+    {
+        for (int instance = 0; instance < newInstanceCount; instance++)
+        {
+            if (instance < keptInstances)
+            {
+                newLocalTransforms[bone * newInstanceCount + instance] = localTransforms[bone * instanceCount + instance];
+            }
+            else
+            {
+                newLocalTransforms[bone * newInstanceCount + instance] = bindLocalTransform[bone];
+            }
+        }
+    }
+
+    localTransforms.swap(newLocalTransforms);
+    worldTransforms.resize(boneCount * newInstanceCount);
+    instanceCount = newInstanceCount;
+}
+
+int SkeletonInstancePool::GetInstanceCount() const
+{
+    return instanceCount;
+}
+
+int SkeletonInstancePool::GetBoneCount() const
+{
+    return boneCount;
+}
+
+void SkeletonInstancePool::SetLocalTransform(int instanceIndex, int boneIndex, const Matrix4x4& newTransform)
+{
+    if (instanceIndex < 0 || instanceIndex >= instanceCount || boneIndex < 0 || boneIndex >= boneCount)
+    {
+        return;
+    }
+
+    localTransforms[boneToSortedIndex[boneIndex] * instanceCount + instanceIndex] = newTransform;
+}
+
+Matrix4x4 SkeletonInstancePool::GetWorldTransform(int instanceIndex, int boneIndex) const
+{
+    if (instanceIndex < 0 || instanceIndex >= instanceCount || boneIndex < 0 || boneIndex >= boneCount)
+    {
+        return Matrix4x4();
+    }
+
+    return worldTransforms[boneToSortedIndex[boneIndex] * instanceCount + instanceIndex];
+}
+
+void SkeletonInstancePool::UpdateWorldTransforms()
+{
+    if (instanceCount == 0)
+    {
+        return;
+    }
+
+    for (int bone = 0; bone < boneCount; bone++)
+    {
+        const Matrix4x4* locals = &localTransforms[bone * instanceCount];
+        Matrix4x4* worlds = &worldTransforms[bone * instanceCount];
+        int parent = sortedParentIndex[bone];
+
+        if (parent < 0)
+        {
+            std::copy(locals, locals + instanceCount, worlds);
+            continue;
+        }
+
+        MultiplyMatrices(&worldTransforms[parent * instanceCount], locals, worlds, instanceCount);
+    }
+}
@@ -0,0 +1,462 @@
+#include "../Headers/Skinning.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ANIMATION_SIMD_SSE 1
+#include <immintrin.h>
+#else
+#define ANIMATION_SIMD_SSE 0
+#endif
+
+// Keeps zero-length normals and zero-weight vertices finite; both come out as zero / unskinned
+static const float SkinningEpsilon = 1e-12f;
+
+int VertexStream::GetVertexCount() const
+{
+    return positionX.size();
+}
+
+void VertexStream::Resize(int vertexCount)
+{
+    for (std::vector<float>* component : { &positionX, &positionY, &positionZ, &normalX, &normalY, &normalZ })
+    {
+        component->resize(vertexCount, 0.0f);
+    }
+}
+
+void VertexStream::SetVertex(int index, const Vector3& position, const Vector3& normal)
+{
+    positionX[index] = position.x;
+    positionY[index] = position.y;
+    positionZ[index] = position.z;
+    normalX[index] = normal.x;
+    normalY[index] = normal.y;
+    normalZ[index] = normal.z;
+}
+
+Vector3 VertexStream::GetPosition(int index) const
+{
+    return Vector3(positionX[index], positionY[index], positionZ[index]);
+}
+
+Vector3 VertexStream::GetNormal(int index) const
+{
+    return Vector3(normalX[index], normalY[index], normalZ[index]);
+}
+
+int SkinnedMesh::GetVertexCount() const
+{
+    return bindVertices.GetVertexCount();
+}
+
+void SkinnedMesh::Resize(int vertexCount, int influences, int bones)
+{
+    influenceCount = std::max(influences, 1);
+    boneCount = std::min(std::max(bones, 0), 65536);
+    bindVertices.Resize(vertexCount);
+    boneIndices.assign(vertexCount * influenceCount, 0);
+    boneWeights.assign(vertexCount * influenceCount, 0.0f);
+}
+
+void SkinnedMesh::SetInfluence(int vertex, int influence, int bone, float weight)
+{
+    if (vertex < 0 || vertex >= GetVertexCount() || influence < 0 || influence >= influenceCount || bone < 0 || bone >= boneCount)
+    {
+        return;
+    }
+
+    int slot = influence * GetVertexCount() + vertex;
+    boneIndices[slot] = bone;
+    boneWeights[slot] = weight;
+}
+
+void SkinnedMesh::NormalizeWeights()
+{
+    int vertexCount = GetVertexCount();
+
+    for (int v = 0; v < vertexCount; v++)
+    {
+        float total = 0.0f;
+        for (int i = 0; i < influenceCount; i++)
+        {
+            total += boneWeights[i * vertexCount + v];
+        }
+
+        if (total <= 0.0f)
+        {
+            continue;
+        }
+
+        for (int i = 0; i < influenceCount; i++)
+        {
+            boneWeights[i * vertexCount + v] /= total;
+        }
+    }
+}
+
+DualQuaternion ToDualQuaternion(const Quaternion& rotation, const Vector3& translation)
+{
+    DualQuaternion result;
+    result.real = rotation;
+    result.dual = Quaternion(translation.x, translation.y, translation.z, 0.0f) * rotation * 0.5f;
+    return result;
+}
+
+void ComputeInverseBindPose(Skeleton& skeleton, std::vector<Transform>& outInverseBindPose)
+{
+    outInverseBindPose.resize(skeleton.GetBoneCount());
+
+    for (int i = 0; i < outInverseBindPose.size(); i++)
+    {
+        outInverseBindPose[i] = Inverse(skeleton.GetWorldPose(i));
+    }
+}
+
+void BuildSkinningPalette(Skeleton& skeleton, const std::vector<Transform>& inverseBindPose, std::vector<Matrix3x4>& outPalette)
+{
+    outPalette.resize(inverseBindPose.size());
+
+    for (int i = 0; i < outPalette.size(); i++)
+    {
+        outPalette[i] = ToMatrix3x4(Combine(skeleton.GetWorldPose(i), inverseBindPose[i]));
+    }
+}
+
+void BuildDualQuaternionPalette(Skeleton& skeleton, const std::vector<Transform>& inverseBindPose, std::vector<DualQuaternion>& outPalette)
+{
+    outPalette.resize(inverseBindPose.size());
+
+    for (int i = 0; i < outPalette.size(); i++)
+    {
+        Transform skin = Combine(skeleton.GetWorldPose(i), inverseBindPose[i]);
+        outPalette[i] = ToDualQuaternion(Normalize(skin.rotation), skin.position);
+    }
+}
+
+static void SkinLinearScalar(const SkinnedMesh& mesh, const Matrix3x4* palette, int begin, int end, VertexStream& out)
+{
+    int vertexCount = mesh.GetVertexCount();
+    const VertexStream& in = mesh.bindVertices;
+
+    for (int v = begin; v < end; v++)
+    {
+        float m[12] = {};
+        for (int i = 0; i < mesh.influenceCount; i++)
+        {
+            int slot = i * vertexCount + v;
+            const float* bone = palette[mesh.boneIndices[slot]].data;
+            float weight = mesh.boneWeights[slot];
+
+            for (int k = 0; k < 12; k++)
+            {
+                m[k] += bone[k] * weight;
+            }
+        }
+
+        Vector3 p = in.GetPosition(v);
+        Vector3 n = in.GetNormal(v);
+
+        out.positionX[v] = m[0] * p.x + m[1] * p.y + m[2] * p.z + m[3];
+        out.positionY[v] = m[4] * p.x + m[5] * p.y + m[6] * p.z + m[7];
+        out.positionZ[v] = m[8] * p.x + m[9] * p.y + m[10] * p.z + m[11];
+
+        // Cofactor rows (determinant times the inverse transpose), signed so mirrored matrices keep normals outward
+        Vector3 row0(m[0], m[1], m[2]), row1(m[4], m[5], m[6]), row2(m[8], m[9], m[10]);
+        Vector3 cofactor0 = Cross(row1, row2), cofactor1 = Cross(row2, row0), cofactor2 = Cross(row0, row1);
+        Vector3 normal(Dot(cofactor0, n), Dot(cofactor1, n), Dot(cofactor2, n));
+        normal = normal * std::copysign(1.0f / std::sqrt(std::max(Dot(normal, normal), SkinningEpsilon)), Dot(row0, cofactor0));
+        out.normalX[v] = normal.x;
+        out.normalY[v] = normal.y;
+        out.normalZ[v] = normal.z;
+    }
+}
+
+static void SkinDualQuaternionScalar(const SkinnedMesh& mesh, const DualQuaternion* palette, int begin, int end, VertexStream& out)
+{
+    int vertexCount = mesh.GetVertexCount();
+    const VertexStream& in = mesh.bindVertices;
+
+    for (int v = begin; v < end; v++)
+    {
+        // Flip influences into the first one's hemisphere so blending takes the short way round
+        const Quaternion& pivot = palette[mesh.boneIndices[v]].real;
+        Quaternion real(0.0f, 0.0f, 0.0f, 0.0f);
+        Quaternion dual(0.0f, 0.0f, 0.0f, 0.0f);
+
+        for (int i = 0; i < mesh.influenceCount; i++)
+        {
+            int slot = i * vertexCount + v;
+            const DualQuaternion& bone = palette[mesh.boneIndices[slot]];
+            float weight = std::copysign(mesh.boneWeights[slot], Dot(bone.real, pivot));
+
+            real = real + bone.real * weight;
+            dual = dual + bone.dual * weight;
+        }
+
+        float inverseLength = 1.0f / std::sqrt(std::max(Dot(real, real), SkinningEpsilon));
+        real = real * inverseLength;
+        dual = dual * inverseLength;
+
+        // Translation is 2 * dual * conjugate(real)
+        Vector3 realVector(real.x, real.y, real.z);
+        Vector3 dualVector(dual.x, dual.y, dual.z);
+        Vector3 translation = (dualVector * real.w - realVector * dual.w + Cross(realVector, dualVector)) * 2.0f;
+
+        Vector3 p = in.GetPosition(v);
+        Vector3 n = in.GetNormal(v);
+        Vector3 position = Rotate(real, p) + translation;
+        Vector3 normal = Rotate(real, n);
+
+        out.positionX[v] = position.x;
+        out.positionY[v] = position.y;
+        out.positionZ[v] = position.z;
+        out.normalX[v] = normal.x;
+        out.normalY[v] = normal.y;
+        out.normalZ[v] = normal.z;
+    }
+}
+
+#if ANIMATION_SIMD_SSE
+static inline __m128 MultiplyAdd(__m128 a, __m128 b, __m128 c)
+{
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+
+static inline void CrossSoA(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz, __m128& outX, __m128& outY, __m128& outZ)
+{
+    outX = _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by));
+    outY = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz));
+    outZ = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+}
+
+// Blends 4 vertices' matrices row by row, then transposes them so the transform itself runs over 4 vertices at once
+template <int InfluenceCount>
+static void SkinLinearSSE(const SkinnedMesh& mesh, const Matrix3x4* palette, int begin, int end, VertexStream& out)
+{
+    int vertexCount = mesh.GetVertexCount();
+    const VertexStream& in = mesh.bindVertices;
+    float* outPosition[3] = { out.positionX.data(), out.positionY.data(), out.positionZ.data() };
+    float* outNormal[3] = { out.normalX.data(), out.normalY.data(), out.normalZ.data() };
+
+    int v = begin;
+    for (; v + 4 <= end; v += 4)
+    {
+        // rows[r][lane] is row r of that lane's blended matrix
+        __m128 rows[3][4];
+        for (int lane = 0; lane < 4; lane++)
+        {
+            __m128 row0 = _mm_setzero_ps();
+            __m128 row1 = _mm_setzero_ps();
+            __m128 row2 = _mm_setzero_ps();
+
+            for (int i = 0; i < InfluenceCount; i++)
+            {
+                int slot = i * vertexCount + v + lane;
+                const float* bone = palette[mesh.boneIndices[slot]].data;
+                __m128 weight = _mm_set1_ps(mesh.boneWeights[slot]);
+
+                row0 = MultiplyAdd(_mm_loadu_ps(bone), weight, row0);
+                row1 = MultiplyAdd(_mm_loadu_ps(bone + 4), weight, row1);
+                row2 = MultiplyAdd(_mm_loadu_ps(bone + 8), weight, row2);
+            }
+
+            rows[0][lane] = row0;
+            rows[1][lane] = row1;
+            rows[2][lane] = row2;
+        }
+
+        // Afterwards rows[r][c] holds element (r, c) of all 4 matrices
+        for (int r = 0; r < 3; r++)
+        {
+            _MM_TRANSPOSE4_PS(rows[r][0], rows[r][1], rows[r][2], rows[r][3]);
+        }
+
+        __m128 px = _mm_loadu_ps(&in.positionX[v]);
+        __m128 py = _mm_loadu_ps(&in.positionY[v]);
+        __m128 pz = _mm_loadu_ps(&in.positionZ[v]);
+        __m128 nx = _mm_loadu_ps(&in.normalX[v]);
+        __m128 ny = _mm_loadu_ps(&in.normalY[v]);
+        __m128 nz = _mm_loadu_ps(&in.normalZ[v]);
+
+        for (int r = 0; r < 3; r++)
+        {
+            __m128 position = MultiplyAdd(rows[r][0], px, MultiplyAdd(rows[r][1], py, MultiplyAdd(rows[r][2], pz, rows[r][3])));
+            _mm_storeu_ps(outPosition[r] + v, position);
+        }
+
+        // Normals by the cofactor rows, as in the scalar path
+        __m128 cofactor[3][3];
+        for (int r = 0; r < 3; r++)
+        {
+            int a = (r + 1) % 3;
+            int b = (r + 2) % 3;
+            CrossSoA(rows[a][0], rows[a][1], rows[a][2], rows[b][0], rows[b][1], rows[b][2], cofactor[r][0], cofactor[r][1], cofactor[r][2]);
+        }
+
+        __m128 normal[3];
+        for (int r = 0; r < 3; r++)
+        {
+            normal[r] = MultiplyAdd(cofactor[r][0], nx, MultiplyAdd(cofactor[r][1], ny, _mm_mul_ps(cofactor[r][2], nz)));
+        }
+
+        __m128 determinant = MultiplyAdd(rows[0][0], cofactor[0][0], MultiplyAdd(rows[0][1], cofactor[0][1], _mm_mul_ps(rows[0][2], cofactor[0][2])));
+        __m128 lengthSquared = MultiplyAdd(normal[0], normal[0], MultiplyAdd(normal[1], normal[1], _mm_mul_ps(normal[2], normal[2])));
+        __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(lengthSquared, _mm_set1_ps(SkinningEpsilon))));
+        inverseLength = _mm_xor_ps(inverseLength, _mm_and_ps(determinant, _mm_set1_ps(-0.0f)));
+        for (int r = 0; r < 3; r++)
+        {
+            _mm_storeu_ps(outNormal[r] + v, _mm_mul_ps(normal[r], inverseLength));
+        }
+    }
+
+    SkinLinearScalar(mesh, palette, v, end, out);
+}
+
+// Blends 4 vertices' dual quaternions as xyzw registers, then transposes them to run normalization and transform over 4 vertices
+template <int InfluenceCount>
+static void SkinDualQuaternionSSE(const SkinnedMesh& mesh, const DualQuaternion* palette, int begin, int end, VertexStream& out)
+{
+    int vertexCount = mesh.GetVertexCount();
+    const VertexStream& in = mesh.bindVertices;
+
+    int v = begin;
+    for (; v + 4 <= end; v += 4)
+    {
+        __m128 real[4];
+        __m128 dual[4];
+        for (int lane = 0; lane < 4; lane++)
+        {
+            const Quaternion& pivot = palette[mesh.boneIndices[v + lane]].real;
+            __m128 realSum = _mm_setzero_ps();
+            __m128 dualSum = _mm_setzero_ps();
+
+            for (int i = 0; i < InfluenceCount; i++)
+            {
+                int slot = i * vertexCount + v + lane;
+                const DualQuaternion& bone = palette[mesh.boneIndices[slot]];
+                float weight = std::copysign(mesh.boneWeights[slot], Dot(bone.real, pivot));
+                __m128 weights = _mm_set1_ps(weight);
+
+                realSum = MultiplyAdd(_mm_loadu_ps(&bone.real.x), weights, realSum);
+                dualSum = MultiplyAdd(_mm_loadu_ps(&bone.dual.x), weights, dualSum);
+            }
+
+            real[lane] = realSum;
+            dual[lane] = dualSum;
+        }
+
+        // Now real[0..3] are the x, y, z, w components of the 4 vertices' blends
+        _MM_TRANSPOSE4_PS(real[0], real[1], real[2], real[3]);
+        _MM_TRANSPOSE4_PS(dual[0], dual[1], dual[2], dual[3]);
+
+        __m128 lengthSquared = MultiplyAdd(real[0], real[0], MultiplyAdd(real[1], real[1], MultiplyAdd(real[2], real[2], _mm_mul_ps(real[3], real[3]))));
+        __m128 inverseLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(lengthSquared, _mm_set1_ps(SkinningEpsilon))));
+        for (int k = 0; k < 4; k++)
+        {
+            real[k] = _mm_mul_ps(real[k], inverseLength);
+            dual[k] = _mm_mul_ps(dual[k], inverseLength);
+        }
+
+        // Translation is 2 * (real.w * dual.xyz - dual.w * real.xyz + real.xyz x dual.xyz)
+        __m128 two = _mm_set1_ps(2.0f);
+        __m128 tx, ty, tz;
+        CrossSoA(real[0], real[1], real[2], dual[0], dual[1], dual[2], tx, ty, tz);
+        tx = _mm_mul_ps(two, _mm_add_ps(tx, _mm_sub_ps(_mm_mul_ps(real[3], dual[0]), _mm_mul_ps(dual[3], real[0]))));
+        ty = _mm_mul_ps(two, _mm_add_ps(ty, _mm_sub_ps(_mm_mul_ps(real[3], dual[1]), _mm_mul_ps(dual[3], real[1]))));
+        tz = _mm_mul_ps(two, _mm_add_ps(tz, _mm_sub_ps(_mm_mul_ps(real[3], dual[2]), _mm_mul_ps(dual[3], real[2]))));
+
+        const float* inComponents[2][3] = {
+            { &in.positionX[v], &in.positionY[v], &in.positionZ[v] },
+            { &in.normalX[v], &in.normalY[v], &in.normalZ[v] }
+        };
+        float* outComponents[2][3] = {
+            { &out.positionX[v], &out.positionY[v], &out.positionZ[v] },
+            { &out.normalX[v], &out.normalY[v], &out.normalZ[v] }
+        };
+
+        // Rotate: v' = v + w * t + q.xyz x t, with t = 2 * (q.xyz x v); positions also get the translation
+        for (int stream = 0; stream < 2; stream++)
+        {
+            __m128 x = _mm_loadu_ps(inComponents[stream][0]);
+            __m128 y = _mm_loadu_ps(inComponents[stream][1]);
+            __m128 z = _mm_loadu_ps(inComponents[stream][2]);
+
+            __m128 cx, cy, cz;
+            CrossSoA(real[0], real[1], real[2], x, y, z, cx, cy, cz);
+            cx = _mm_mul_ps(cx, two);
+            cy = _mm_mul_ps(cy, two);
+            cz = _mm_mul_ps(cz, two);
+
+            __m128 dx, dy, dz;
+            CrossSoA(real[0], real[1], real[2], cx, cy, cz, dx, dy, dz);
+            x = _mm_add_ps(x, MultiplyAdd(real[3], cx, dx));
+            y = _mm_add_ps(y, MultiplyAdd(real[3], cy, dy));
+            z = _mm_add_ps(z, MultiplyAdd(real[3], cz, dz));
+
+            if (stream == 0)
+            {
+                x = _mm_add_ps(x, tx);
+                y = _mm_add_ps(y, ty);
+                z = _mm_add_ps(z, tz);
+            }
+
+            _mm_storeu_ps(outComponents[stream][0], x);
+            _mm_storeu_ps(outComponents[stream][1], y);
+            _mm_storeu_ps(outComponents[stream][2], z);
+        }
+    }
+
+    SkinDualQuaternionScalar(mesh, palette, v, end, out);
+}
+#endif
+
+void SkinVerticesLinear(const SkinnedMesh& mesh, const Matrix3x4* palette, int begin, int end, VertexStream& outVertices)
+{
+    begin = std::max(begin, 0);
+    end = std::min(end, mesh.GetVertexCount());
+    if (begin >= end || outVertices.GetVertexCount() < mesh.GetVertexCount())
+    {
+        return;
+    }
+
+#if ANIMATION_SIMD_SSE
+    if (mesh.influenceCount == 4)
+    {
+        SkinLinearSSE<4>(mesh, palette, begin, end, outVertices);
+        return;
+    }
+    if (mesh.influenceCount == 8)
+    {
+        SkinLinearSSE<8>(mesh, palette, begin, end, outVertices);
+        return;
+    }
+#endif
+
+    SkinLinearScalar(mesh, palette, begin, end, outVertices);
+}
+
+void SkinVerticesDualQuaternion(const SkinnedMesh& mesh, const DualQuaternion* palette, int begin, int end, VertexStream& outVertices)
+{
+    begin = std::max(begin, 0);
+    end = std::min(end, mesh.GetVertexCount());
+    if (begin >= end || outVertices.GetVertexCount() < mesh.GetVertexCount())
+    {
+        return;
+    }
+
+#if ANIMATION_SIMD_SSE
+    if (mesh.influenceCount == 4)
+    {
+        SkinDualQuaternionSSE<4>(mesh, palette, begin, end, outVertices);
+        return;
+    }
+    if (mesh.influenceCount == 8)
+    {
+        SkinDualQuaternionSSE<8>(mesh, palette, begin, end, outVertices);
+        return;
+    }
+#endif
+
+    SkinDualQuaternionScalar(mesh, palette, begin, end, outVertices);
+}
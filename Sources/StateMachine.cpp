@@ -2,40 +2,362 @@
 
 #include <iostream>
 
-StateMachine::StateMachine(State _BaseState) : currentState(_BaseState), speed(0.0f), isGrounded(false)
+// Seconds of float rounding accepted when checking whether a cross-fade has run its full duration
+static const float TransitionTimeTolerance = 0.00001f;
+
+static inline bool EvaluateCondition(ConditionOp op, float parameter, float value)
 {
-    transitions.push_back({ Idle, Walk, [this] { return speed > 0; } });
-    transitions.push_back({ Walk, Run, [this] { return speed > 5; } });
-    transitions.push_back({ Run, Walk, [this] { return speed <= 5; } });
-    transitions.push_back({ Walk, Idle, [this] { return speed == 0; } });
-    transitions.push_back({ Any, Jump, [this] { return isGrounded == false; } });
-    transitions.push_back({ Jump, Idle, [this] { return isGrounded == true; } });
+    switch (op)
+    {
+    case Greater:
+        return parameter > value;
+    case GreaterEqual:
+        return parameter >= value;
+    case Less:
+        return parameter < value;
+    case LessEqual:
+        return parameter <= value;
+    case Equal:
+        return parameter == value;
+    case NotEqual:
+        return parameter != value;
+    }
+    return false;
 }
 
-std::string StateMachine::getCurrentState()
+float EvaluateBlendCurve(BlendCurve curve, float t)
+{
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+
+    switch (curve)
+    {
+    case CurveSmoothStep:
+        return t * t * (3.0f - 2.0f * t);
+    case CurveEaseIn:
+        return t * t;
+    case CurveEaseOut:
+        return t * (2.0f - t);
+    default:
+        return t;
+    }
+}
+
+bool StateMachineInstance::isTransitioning() const
+{
+    return previousState >= 0;
+}
+
+float StateMachineInstance::getTransitionWeight() const
+{
+    if (!isTransitioning() || transitionDuration <= 0.0f)
+    {
+        return 1.0f;
+    }
+
+    return EvaluateBlendCurve(transitionCurve, transitionTime / transitionDuration);
+}
+
+int StateMachineGraph::addState(const std::string& name)
+{
+    stateNames.push_back(name);
+    rebuildStateTransitions();
+    return stateNames.size() - 1;
+}
+
+int StateMachineGraph::addParameter(const std::string& name)
+{
+    if (parameterNames.size() >= MaxStateMachineParameters)
+    {
+        return -1;
+    }
+
+    parameterNames.push_back(name);
+    return parameterNames.size() - 1;
+}
+
+void StateMachineGraph::addTransition(int from, int to, std::initializer_list<TransitionCondition> newConditions, float duration, BlendCurve curve)
+{
+    if ((from != AnyState && (from < 0 || from >= stateNames.size())) || to < 0 || to >= stateNames.size())
+    {
+        return;
+    }
+
+    for (const TransitionCondition& condition : newConditions)
+    {
+        if (condition.parameter >= parameterNames.size())
+        {
+            return;
+        }
+    }
+
+    transitions.push_back({ from, to, (int)conditions.size(), (int)newConditions.size(), duration > 0.0f ? duration : 0.0f, curve });
+    conditions.insert(conditions.end(), newConditions.begin(), newConditions.end());
+    rebuildStateTransitions();
+}
+
+int StateMachineGraph::getStateCount() const
 {
-    switch (currentState)
+    return stateNames.size();
+}
+
+const std::string& StateMachineGraph::getStateName(int state) const
+{
+    static const std::string Unknown = "Unknown";
+
+    if (state < 0 || state >= stateNames.size())
     {
-    case Idle:
-        return "Idle";
-    case Walk:
-        return "Walk";
-    case Run:
-        return "Run";
-    case Jump:
-        return "Jump";
+        return Unknown;
     }
-    return "Unknown";
+
+    return stateNames[state];
 }
 
-void StateMachine::update()
+int StateMachineGraph::findParameter(const std::string& name) const
 {
-    for (Transition transition : transitions)
+    for (int i = 0; i < parameterNames.size(); i++)
     {
-        if ((transition.from == currentState || transition.from == Any) && transition.condition())
+        if (parameterNames[i] == name)
         {
-            currentState = transition.to;
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+StateMachineInstance StateMachineGraph::createInstance(int initialState) const
+{
+    StateMachineInstance instance = StateMachineInstance();
+    instance.currentState = initialState;
+    instance.previousState = -1;
+    return instance;
+}
+
+void StateMachineGraph::update(StateMachineInstance& instance, float deltaTime) const
+{
+    advanceTransition(instance, deltaTime);
+
+    if (instance.currentState < 0 || instance.currentState >= stateNames.size())
+    {
+        return;
+    }
+
+    int begin = stateTransitionStart[instance.currentState];
+    int end = stateTransitionStart[instance.currentState + 1];
+
+    for (int i = begin; i < end; i++)
+    {
+        const Transition& transition = transitions[stateTransitionIndices[i]];
+        bool fires = true;
+
+        for (int c = 0; c < transition.conditionCount && fires; c++)
+        {
+            const TransitionCondition& condition = conditions[transition.firstCondition + c];
+            fires = EvaluateCondition(condition.op, instance.parameters[condition.parameter], condition.value);
+        }
+
+        if (fires)
+        {
+            startTransition(instance, transition);
             return;
         }
     }
 }
+
+void StateMachineGraph::updateAll(StateMachineInstance* instances, int count, float deltaTime) const
+{
+    const int BlockSize = 16;
+
+    for (int base = 0; base < count; base += BlockSize)
+    {
+        int laneCount = count - base < BlockSize ? count - base : BlockSize;
+        StateMachineInstance* block = instances + base;
+
+        int current[BlockSize];
+        int next[BlockSize];
+        bool pending[BlockSize];
+        bool fires[BlockSize];
+
+        for (int lane = 0; lane < laneCount; lane++)
+        {
+            advanceTransition(block[lane], deltaTime);
+            current[lane] = block[lane].currentState;
+            next[lane] = -1;
+            pending[lane] = current[lane] >= 0 && current[lane] < (int)stateNames.size();
+        }
+
+        // Transition-major: every lane tests the same transition, so the op switch stays outside the lane loops
+        for (int t = 0; t < (int)transitions.size(); t++)
+        {
+            const Transition& transition = transitions[t];
+
+            for (int lane = 0; lane < laneCount; lane++)
+            {
+                fires[lane] = pending[lane] & (transition.from == AnyState || current[lane] == transition.from);
+            }
+
+            for (int c = 0; c < transition.conditionCount; c++)
+            {
+                const TransitionCondition& condition = conditions[transition.firstCondition + c];
+                int parameter = condition.parameter;
+                float value = condition.value;
+
+                switch (condition.op)
+                {
+                case Greater:
+                    for (int lane = 0; lane < laneCount; lane++) { fires[lane] &= block[lane].parameters[parameter] > value; }
+                    break;
+                case GreaterEqual:
+                    for (int lane = 0; lane < laneCount; lane++) { fires[lane] &= block[lane].parameters[parameter] >= value; }
+                    break;
+                case Less:
+                    for (int lane = 0; lane < laneCount; lane++) { fires[lane] &= block[lane].parameters[parameter] < value; }
+                    break;
+                case LessEqual:
+                    for (int lane = 0; lane < laneCount; lane++) { fires[lane] &= block[lane].parameters[parameter] <= value; }
+                    break;
+                case Equal:
+                    for (int lane = 0; lane < laneCount; lane++) { fires[lane] &= block[lane].parameters[parameter] == value; }
+                    break;
+                case NotEqual:
+                    for (int lane = 0; lane < laneCount; lane++) { fires[lane] &= block[lane].parameters[parameter] != value; }
+                    break;
+                }
+            }
+
+            for (int lane = 0; lane < laneCount; lane++)
+            {
+                next[lane] = fires[lane] ? t : next[lane];
+                pending[lane] &= !fires[lane];
+            }
+        }
+
+        for (int lane = 0; lane < laneCount; lane++)
+        {
+            if (next[lane] >= 0)
+            {
+                startTransition(block[lane], transitions[next[lane]]);
+            }
+        }
+    }
+}
+
+void StateMachineGraph::advanceTransition(StateMachineInstance& instance, float deltaTime)
+{
+    if (!instance.isTransitioning())
+    {
+        return;
+    }
+
+    // Accumulated frame times can land just short of the duration, which no later zero-delta update would close
+    instance.transitionTime += deltaTime;
+    if (instance.transitionTime >= instance.transitionDuration - TransitionTimeTolerance)
+    {
+        instance.previousState = -1;
+    }
+}
+
+void StateMachineGraph::startTransition(StateMachineInstance& instance, const Transition& transition)
+{
+    // Re-entering the current state (e.g. an AnyState transition) must not restart its cross-fade
+    if (transition.to == instance.currentState)
+    {
+        return;
+    }
+
+    // An interrupted cross-fade snaps to its target and fades out from there
+    instance.previousState = transition.duration > 0.0f ? instance.currentState : -1;
+    instance.currentState = transition.to;
+    instance.transitionTime = 0.0f;
+    instance.transitionDuration = transition.duration;
+    instance.transitionCurve = transition.curve;
+}
+
+void StateMachineGraph::rebuildStateTransitions()
+{
+    stateTransitionStart.assign(stateNames.size() + 1, 0);
+    stateTransitionIndices.clear();
+
+    for (int state = 0; state < stateNames.size(); state++)
+    {
+        stateTransitionStart[state] = stateTransitionIndices.size();
+
+        for (int i = 0; i < transitions.size(); i++)
+        {
+            if (transitions[i].from == state || transitions[i].from == AnyState)
+            {
+                stateTransitionIndices.push_back(i);
+            }
+        }
+    }
+
+    stateTransitionStart[stateNames.size()] = stateTransitionIndices.size();
+}
+
+// Locomotion graph parameters
+static const uint8_t SpeedParameter = 0;
+static const uint8_t IsGroundedParameter = 1;
+
+const StateMachineGraph& StateMachine::getLocomotionGraph()
+{
+    static const StateMachineGraph graph = []
+    {
+        StateMachineGraph locomotion;
+
+        // Added in State enum order so State values are graph state indices
+        locomotion.addState("Idle");
+        locomotion.addState("Walk");
+        locomotion.addState("Run");
+        locomotion.addState("Jump");
+        locomotion.addParameter("speed");
+        locomotion.addParameter("isGrounded");
+
+        locomotion.addTransition(Idle, Walk, { { SpeedParameter, Greater, 0.0f } }, 0.2f, CurveSmoothStep);
+        locomotion.addTransition(Walk, Run, { { SpeedParameter, Greater, 5.0f } }, 0.25f, CurveSmoothStep);
+        locomotion.addTransition(Run, Walk, { { SpeedParameter, LessEqual, 5.0f } }, 0.25f, CurveSmoothStep);
+        locomotion.addTransition(Walk, Idle, { { SpeedParameter, Equal, 0.0f } }, 0.2f, CurveSmoothStep);
+        locomotion.addTransition(AnyState, Jump, { { IsGroundedParameter, Equal, 0.0f } }, 0.1f, CurveEaseOut);
+        locomotion.addTransition(Jump, Idle, { { IsGroundedParameter, Equal, 1.0f } }, 0.15f, CurveSmoothStep);
+
+        return locomotion;
+    }();
+
+    return graph;
+}
+
+StateMachine::StateMachine(State _BaseState) : speed(0.0f), isGrounded(false)
+{
+    instance = getLocomotionGraph().createInstance(_BaseState);
+}
+
+std::string StateMachine::getCurrentState()
+{
+    return getLocomotionGraph().getStateName(instance.currentState);
+}
+
+void StateMachine::update(float deltaTime)
+{
+    instance.parameters[SpeedParameter] = speed;
+    instance.parameters[IsGroundedParameter] = isGrounded ? 1.0f : 0.0f;
+    getLocomotionGraph().update(instance, deltaTime);
+}
+
+std::string StateMachine::getPreviousState()
+{
+    return getLocomotionGraph().getStateName(instance.previousState);
+}
+
+bool StateMachine::isTransitioning() const
+{
+    return instance.isTransitioning();
+}
+
+float StateMachine::getTransitionWeight() const
+{
+    return instance.getTransitionWeight();
+}
+
+const StateMachineInstance& StateMachine::getInstance() const
+{
+    return instance;
+}
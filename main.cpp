@@ -1,12 +1,26 @@
 #include "Headers/StateMachine.h"
 #include "Headers/BlendTree1D.h"
+#include "Headers/BlendSpace2D.h"
 #include "Headers/Skeleton.h"
+#include "Headers/SkeletonInstancePool.h"
 #include "Headers/AnimationBlending.h"
+#include "Headers/AnimationClip.h"
+#include "Headers/AnimationFile.h"
+#include "Headers/AnimationGraph.h"
+#include "Headers/AnimationUpdate.h"
+#include "Headers/AnimationProfiler.h"
+#include "Headers/FrameArena.h"
+#include "Headers/JobSystem.h"
 #include "Headers/IKSolver.h"
+#include "Headers/Skinning.h"
 
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
 
 #pragma region Tests
 void TestStateMachine()
@@ -45,6 +59,74 @@ void TestStateMachine()
     std::cout << "Test 5 (Idle -> Walk): " << sm.getCurrentState() << std::endl;
     assert(sm.getCurrentState() == "Walk");
 
+    // Shared data-driven graph, bulk update must match per-instance update
+    StateMachineGraph graph;
+    int crouch = graph.addState("Crouch");
+    int stand = graph.addState("Stand");
+    int sprint = graph.addState("Sprint");
+    uint8_t stamina = graph.addParameter("stamina");
+    uint8_t crouchInput = graph.addParameter("crouch");
+    graph.addTransition(AnyState, crouch, { { crouchInput, Equal, 1.0f } });
+    graph.addTransition(crouch, stand, { { crouchInput, Equal, 0.0f } });
+    graph.addTransition(stand, sprint, { { stamina, Greater, 0.5f }, { crouchInput, NotEqual, 1.0f } });
+    graph.addTransition(sprint, stand, { { stamina, LessEqual, 0.1f } });
+
+    std::vector<StateMachineInstance> bulk(37), single(37);
+    for (int i = 0; i < 37; i++)
+    {
+        bulk[i] = graph.createInstance(i % 3);
+        bulk[i].parameters[stamina] = (i % 10) / 10.0f;
+        bulk[i].parameters[crouchInput] = i % 4 == 0 ? 1.0f : 0.0f;
+        single[i] = bulk[i];
+    }
+
+    for (int step = 0; step < 3; step++)
+    {
+        graph.updateAll(bulk.data(), bulk.size());
+        for (StateMachineInstance& instance : single)
+        {
+            graph.update(instance);
+        }
+    }
+
+    for (int i = 0; i < 37; i++)
+    {
+        assert(bulk[i].currentState == single[i].currentState);
+    }
+    assert(graph.getStateName(bulk[4].currentState) == "Crouch");
+    assert(graph.getStateName(bulk[9].currentState) == "Sprint");
+    std::cout << "Test 6 (graph updateAll == update): PASSED" << std::endl;
+
+    // Timed cross-fade: the target state is current at once, the weight follows the curve over the duration
+    StateMachine fading(Idle);
+    fading.isGrounded = true;
+    fading.speed = 2.0f;
+    fading.update(0.05f);
+    assert(fading.getCurrentState() == "Walk" && fading.getPreviousState() == "Idle");
+    assert(fading.isTransitioning() && fading.getTransitionWeight() == 0.0f);
+    fading.update(0.1f);
+    assert(std::abs(fading.getTransitionWeight() - 0.5f) < 0.0001f);
+    fading.update(0.1f);
+    assert(!fading.isTransitioning() && fading.getTransitionWeight() == 1.0f);
+    std::cout << "Test 7 (Idle -> Walk cross-fade): PASSED" << std::endl;
+
+    // Ten 0.02s steps sum to just under the 0.2s fade in float; it must still finish, and stay finished at zero delta
+    StateMachine stepped(Idle);
+    stepped.isGrounded = true;
+    stepped.speed = 2.0f;
+    stepped.update(0.0f);
+    for (int step = 0; step < 9; step++)
+    {
+        stepped.update(0.02f);
+    }
+    stepped.update(0.0f);
+    assert(stepped.isTransitioning());
+    stepped.update(0.02f);
+    assert(!stepped.isTransitioning());
+    stepped.update(0.0f);
+    assert(!stepped.isTransitioning() && stepped.getCurrentState() == "Walk");
+    std::cout << "Test 8 (cross-fade ends on accumulated steps): PASSED" << std::endl;
+
     std::cout << "All State Machine tests passed!" << std::endl;
 }
 
@@ -80,9 +162,123 @@ void TestBlendTree1D()
     std::cout << "Test 6 (speed=8.0, clamped): ";
     blendTree.printWeights(8.0f);
 
+    // Sparse result: at most the two clips around the parameter
+    BlendWeights1D weights = blendTree.calculateWeights(4.5f);
+    assert(weights.count == 2 && weights.samples[0].clipIndex == 1 && weights.samples[1].clipIndex == 2);
+    assert(std::abs(weights.samples[0].weight - 0.5f) < 0.0001f && std::abs(weights.samples[1].weight - 0.5f) < 0.0001f);
+    weights = blendTree.calculateWeights(3.0f);
+    assert(weights.count == 1 && weights.samples[0].clipIndex == 1 && weights.samples[0].weight == 1.0f);
+    assert(BlendTree1D().calculateWeights(1.0f).count == 0);
+
+    // Thresholds added out of order are sorted, batch matches single evaluation
+    BlendTree1D unsorted;
+    unsorted.addAnimation(6.0f, &run);
+    unsorted.addAnimation(0.0f, &idle);
+    unsorted.addAnimation(3.0f, &walk);
+    assert(unsorted.getClip(0) == &idle && unsorted.getClip(1) == &walk && unsorted.getClip(2) == &run);
+
+    std::vector<float> parameters;
+    for (int i = 0; i < 50; i++)
+    {
+        parameters.push_back(-1.0f + 0.2f * i);
+    }
+    std::vector<BlendWeights1D> batch(parameters.size());
+    unsorted.calculateWeights(parameters.data(), batch.data(), parameters.size());
+    for (int i = 0; i < parameters.size(); i++)
+    {
+        BlendWeights1D single = blendTree.calculateWeights(parameters[i]);
+        assert(batch[i].count == single.count);
+        for (int k = 0; k < single.count; k++)
+        {
+            assert(batch[i].samples[k].clipIndex == single.samples[k].clipIndex && batch[i].samples[k].weight == single.samples[k].weight);
+        }
+    }
+    std::cout << "Test 7 (sorted thresholds, batch weights): PASSED" << std::endl;
+
     std::cout << "All Blend Tree 1D tests passed!" << std::endl;
 }
 
+void TestBlendSpace2D()
+{
+    std::cout << "\n=== BLEND SPACE 2D TESTS ===" << std::endl;
+
+    AnimationClip idle{ "Idle", 1.0f };
+    AnimationClip forward{ "Forward", 1.0f };
+    AnimationClip backward{ "Backward", 1.0f };
+    AnimationClip left{ "Left", 1.0f };
+    AnimationClip right{ "Right", 1.0f };
+
+    // Directional diamond around idle: 4 triangles
+    BlendSpace2D blendSpace;
+    blendSpace.addAnimation(0.0f, 0.0f, &idle);
+    blendSpace.addAnimation(1.0f, 0.0f, &right);
+    blendSpace.addAnimation(-1.0f, 0.0f, &left);
+    blendSpace.addAnimation(0.0f, 1.0f, &forward);
+    blendSpace.addAnimation(0.0f, -1.0f, &backward);
+    assert(blendSpace.getTriangleCount() == 4);
+
+    BlendWeights2D weights = blendSpace.calculateWeights(0.0f, 0.0f);
+    assert(weights.count == 1 && weights.samples[0].clipIndex == 0 && std::abs(weights.samples[0].weight - 1.0f) < 0.0001f);
+
+    std::cout << "Test 1 (0.25, 0.25): ";
+    blendSpace.printWeights(0.25f, 0.25f);
+    weights = blendSpace.calculateWeights(0.25f, 0.25f);
+    assert(weights.count == 3);
+    for (int i = 0; i < weights.count; i++)
+    {
+        float expected = weights.samples[i].clipIndex == 0 ? 0.5f : 0.25f;
+        assert(std::abs(weights.samples[i].weight - expected) < 0.0001f);
+    }
+
+    // Outside the hull: projected onto the nearest edge or vertex
+    std::cout << "Test 2 (1, 1, outside): ";
+    blendSpace.printWeights(1.0f, 1.0f);
+    weights = blendSpace.calculateWeights(1.0f, 1.0f);
+    assert(weights.count == 2 && std::abs(weights.samples[0].weight - 0.5f) < 0.0001f);
+    weights = blendSpace.calculateWeights(3.0f, 0.0f);
+    assert(weights.count == 1 && weights.samples[0].clipIndex == 1);
+
+    // Weights reproduce the parameter anywhere inside a jittered grid of clips
+    BlendSpace2D grid;
+    std::vector<float> xs, ys;
+    for (int i = 0; i < 25; i++)
+    {
+        xs.push_back(i % 5 + 0.1f * ((i * 7) % 3));
+        ys.push_back(i / 5 + 0.1f * ((i * 5) % 4));
+        grid.addAnimation(xs.back(), ys.back(), &idle);
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        float x = 0.5f + 3.0f * (i % 10) / 9.0f;
+        float y = 0.5f + 3.0f * (i / 10) / 9.0f;
+        weights = grid.calculateWeights(x, y);
+        assert(weights.count >= 1 && weights.count <= 3);
+
+        float total = 0.0f, reconstructedX = 0.0f, reconstructedY = 0.0f;
+        for (int k = 0; k < weights.count; k++)
+        {
+            total += weights.samples[k].weight;
+            reconstructedX += weights.samples[k].weight * xs[weights.samples[k].clipIndex];
+            reconstructedY += weights.samples[k].weight * ys[weights.samples[k].clipIndex];
+        }
+        assert(std::abs(total - 1.0f) < 0.0001f);
+        assert(std::abs(reconstructedX - x) < 0.001f && std::abs(reconstructedY - y) < 0.001f);
+    }
+    std::cout << "Test 3 (barycentric reconstruction): PASSED" << std::endl;
+
+    // Collinear clips fall back to a 1D blend along the line
+    BlendSpace2D line;
+    line.addAnimation(0.0f, 0.0f, &idle);
+    line.addAnimation(2.0f, -2.0f, &right);
+    line.addAnimation(1.0f, -1.0f, &forward);
+    weights = line.calculateWeights(1.5f, -1.5f);
+    assert(line.getTriangleCount() == 0 && weights.count == 2);
+    assert(std::abs(weights.samples[0].weight - 0.5f) < 0.0001f && std::abs(weights.samples[1].weight - 0.5f) < 0.0001f);
+    std::cout << "Test 4 (collinear clips): PASSED" << std::endl;
+
+    std::cout << "All Blend Space 2D tests passed!" << std::endl;
+}
+
 void TestSkeleton()
 {
     std::cout << "\n=== SKELETON HIERARCHY TESTS ===" << std::endl;
@@ -103,12 +299,30 @@ void TestSkeleton()
     assert(skeleton.FindBone("Elbow") == 3);
     assert(skeleton.FindBone("Hand") == 4);
     assert(skeleton.FindBone("NonExistent") == -1);
+    assert(skeleton.FindBone("") == -1);
+    assert(skeleton.FindBone(std::string("Elbow")) == 3);
+
+    static constexpr BoneId HandId("Hand");
+    assert(skeleton.FindBone(HandId) == 4);
+    assert(skeleton.FindBone(BoneId("Tail")) == -1);
+    assert(Skeleton().FindBone("Root") == -1); // Empty skeleton
+
+    Skeleton largeSkeleton;
+    for (int i = 0; i < 100; i++)
+    {
+        largeSkeleton.AddBone("Bone" + std::to_string(i), i - 1, Matrix4x4());
+    }
+    for (int i = 0; i < 100; i++)
+    {
+        assert(largeSkeleton.FindBone("Bone" + std::to_string(i)) == i);
+    }
     std::cout << "FindBone tests passed!" << std::endl;
 
     // Test initial state (all identity)
     skeleton.UpdateWorldTransforms();
     Matrix4x4 initialShoulder = skeleton.GetWorldTransform(shoulder);
     assert(initialShoulder.data[0] == 1.0f && initialShoulder.data[5] == 1.0f);
+    assert(skeleton.GetLastUpdatedBoneCount() == 5);
     std::cout << "Initial state test passed!" << std::endl;
 
     // Test rotation propagation - 45 degrees
@@ -119,6 +333,7 @@ void TestSkeleton()
     Matrix4x4 shoulderWorld = skeleton.GetWorldTransform(shoulder);
     Matrix4x4 elbowWorld = skeleton.GetWorldTransform(elbow);
     Matrix4x4 handWorld = skeleton.GetWorldTransform(hand);
+    assert(skeleton.GetLastUpdatedBoneCount() == 3); // Shoulder subtree only
 
     // Verify cos(45) and sin(45) are approximately 0.707
     float cos45 = shoulderWorld.data[0];
@@ -157,9 +372,166 @@ void TestSkeleton()
     assert(spineWorld.data[0] == 1.0f && spineWorld.data[5] == 1.0f);
     std::cout << "Parent isolation test passed!" << std::endl;
 
+    // Dirty subtrees: nothing changed means nothing recomputed
+    skeleton.UpdateWorldTransforms();
+    assert(skeleton.GetLastUpdatedBoneCount() == 0);
+
+    // Branch added after its siblings' children must still be propagated as one subtree
+    int leftArm = skeleton.AddBone("LeftArm", spine, Matrix4x4());
+    skeleton.UpdateWorldTransforms();
+    assert(skeleton.GetLastUpdatedBoneCount() == 1);
+
+    skeleton.SetLocalTransform(spine, rotation90);
+    skeleton.SetLocalTransform(hand, rotation90);
+    skeleton.UpdateWorldTransforms();
+    assert(skeleton.GetLastUpdatedBoneCount() == 5); // Spine, Shoulder, Elbow, Hand, LeftArm
+    assert(skeleton.GetWorldTransform(leftArm).data[4] > 0.999f);
+    std::cout << "Dirty subtree test passed!" << std::endl;
+
     std::cout << "\n=== ALL SKELETON TESTS PASSED ===" << std::endl;
 }
 
+void TestSkeletonPoses()
+{
+    std::cout << "\n=== SKELETON TRS POSE TESTS ===" << std::endl;
+
+    Skeleton skeleton;
+    Transform offset(Vector3(1, 0, 0), Quaternion(), Vector3(1, 1, 1));
+
+    int root = skeleton.AddBone("Root", -1, Transform());
+    int shoulder = skeleton.AddBone("Shoulder", root, offset);
+    int elbow = skeleton.AddBone("Elbow", shoulder, offset);
+    int hand = skeleton.AddBone("Hand", elbow, offset);
+
+    // Bend the shoulder 90 degrees around Z: the hand should end up at (1, 2, 0)
+    Quaternion rotation90 = Quaternion::FromAxisAngle(Vector3(0, 0, 1), 3.14159f / 2.0f);
+    skeleton.SetLocalTransform(shoulder, Transform(Vector3(1, 0, 0), rotation90, Vector3(1, 1, 1)));
+    skeleton.UpdateWorldPoses();
+
+    Transform handWorld = skeleton.GetWorldPose(hand);
+    assert(std::abs(handWorld.position.x - 1.0f) < 0.001f);
+    assert(std::abs(handWorld.position.y - 2.0f) < 0.001f);
+    std::cout << "Pose propagation test passed!" << std::endl;
+
+    // Bones left out of a required-bone update are caught up by the next full update
+    std::vector<int> required;
+    skeleton.GetRequiredBones(&shoulder, 1, required);
+    skeleton.SetLocalTransform(root, Transform(Vector3(10, 0, 0), Quaternion(), Vector3(1, 1, 1)));
+    skeleton.UpdateWorldPoses(required.data(), required.size());
+    assert(std::abs(skeleton.GetWorldPose(shoulder).position.x - 11.0f) < 0.001f);
+    skeleton.UpdateWorldPoses();
+    assert(skeleton.GetLastUpdatedBoneCount() == 2); // Elbow and Hand
+    Transform expectedElbow = Combine(skeleton.GetWorldPose(shoulder), skeleton.GetLocalPose(elbow));
+    assert(Length(skeleton.GetWorldPose(elbow).position - expectedElbow.position) < 0.001f);
+    assert(std::abs(skeleton.GetWorldPose(hand).position.x - 11.0f) < 0.001f);
+    skeleton.SetLocalTransform(root, Transform());
+    skeleton.UpdateWorldPoses();
+    std::cout << "Required bones then full update test passed!" << std::endl;
+
+    // Skinning matrices must match the Matrix4x4 path
+    skeleton.UpdateWorldTransforms();
+    std::vector<Matrix3x4> skinningMatrices;
+    skeleton.GetSkinningMatrices(skinningMatrices);
+    assert(skinningMatrices.size() == 4);
+    for (int bone = 0; bone < 4; bone++)
+    {
+        Matrix4x4 world = skeleton.GetWorldTransform(bone);
+        for (int i = 0; i < 12; i++)
+        {
+            assert(std::abs(skinningMatrices[bone].data[i] - world.data[i]) < 0.001f);
+        }
+    }
+    std::cout << "Matrix path consistency test passed!" << std::endl;
+
+    // Matrix round trip
+    Transform scaled(Vector3(1, 2, 3), Quaternion::FromAxisAngle(Vector3(1, 1, 0), 0.8f), Vector3(2, 2, 2));
+    Transform roundTrip = ToTransform(ToMatrix4x4(scaled));
+    assert(std::abs(roundTrip.rotation.x - scaled.rotation.x) < 0.001f && std::abs(roundTrip.rotation.w - scaled.rotation.w) < 0.001f);
+    assert(std::abs(roundTrip.scale.y - 2.0f) < 0.001f && roundTrip.position.z == 3.0f);
+
+    // A mirroring local matrix round-trips through the skeleton's TRS storage
+    Skeleton mirrored;
+    Matrix4x4 mirror = Matrix4x4();
+    mirror.data[0] = -1.0f;
+    mirror.data[3] = 2.0f;
+    int mirroredBone = mirrored.AddBone("Mirrored", -1, mirror);
+    mirrored.UpdateWorldTransforms();
+    Matrix4x4 mirroredLocal = mirrored.GetLocalTransform(mirroredBone);
+    Matrix4x4 mirroredWorld = mirrored.GetWorldTransform(mirroredBone);
+    for (int i = 0; i < 16; i++)
+    {
+        assert(std::abs(mirroredLocal.data[i] - mirror.data[i]) < 0.0001f);
+        assert(std::abs(mirroredWorld.data[i] - mirror.data[i]) < 0.0001f);
+    }
+    Transform mirroredPose = mirrored.GetLocalPose(mirroredBone);
+    assert(mirroredPose.scale.x == -1.0f && std::abs(Dot(mirroredPose.rotation, Quaternion())) > 0.99999f); // Reflection in the scale, not the rotation
+    std::cout << "Matrix round trip test passed!" << std::endl;
+
+    std::cout << "All Skeleton TRS Pose tests passed!" << std::endl;
+}
+
+void TestSkeletonInstancePool()
+{
+    std::cout << "\n=== SKELETON INSTANCE POOL TESTS ===" << std::endl;
+
+    Skeleton skeleton;
+    int root = skeleton.AddBone("Root", -1, Matrix4x4());
+    int shoulder = skeleton.AddBone("Shoulder", root, Matrix4x4());
+    int elbow = skeleton.AddBone("Elbow", shoulder, Matrix4x4());
+
+    SkeletonInstancePool pool(skeleton, 3);
+    assert(pool.GetInstanceCount() == 3);
+    assert(pool.GetBoneCount() == 3);
+
+    // Only instance 1 rotates its shoulder
+    Matrix4x4 rotation90 = Matrix4x4::RotationZ(3.14159f / 2.0f);
+    pool.SetLocalTransform(1, shoulder, rotation90);
+    pool.UpdateWorldTransforms();
+
+    assert(pool.GetWorldTransform(0, elbow).data[0] == 1.0f);
+    assert(pool.GetWorldTransform(2, elbow).data[0] == 1.0f);
+    assert(pool.GetWorldTransform(1, elbow).data[4] > 0.999f);
+    std::cout << "Per-instance propagation test passed!" << std::endl;
+
+    // Must match the single-skeleton path, which composes TRS poses and rebuilds the matrix on demand
+    skeleton.SetLocalTransform(shoulder, rotation90);
+    skeleton.UpdateWorldTransforms();
+    for (int i = 0; i < 16; i++)
+    {
+        assert(std::abs(pool.GetWorldTransform(1, elbow).data[i] - skeleton.GetWorldTransform(elbow).data[i]) < 0.00001f);
+    }
+    std::cout << "Matches Skeleton test passed!" << std::endl;
+
+    // Growing the pool keeps existing instances and binds new ones
+    pool.SetInstanceCount(5);
+    pool.UpdateWorldTransforms();
+    assert(pool.GetWorldTransform(1, elbow).data[4] > 0.999f);
+    assert(pool.GetWorldTransform(4, elbow).data[0] == 1.0f);
+    std::cout << "Resize test passed!" << std::endl;
+
+    // SIMD batch multiply must match the scalar reference exactly
+    std::vector<Matrix4x4> parents(7), locals(7), simdResults(7), scalarResults(7);
+    for (int i = 0; i < 7; i++)
+    {
+        parents[i] = Matrix4x4::RotationZ(0.3f * i);
+        locals[i] = Matrix4x4::RotationZ(-0.7f * i);
+        locals[i].data[3] = 1.5f * i;
+        locals[i].data[7] = -0.25f * i;
+    }
+    MultiplyMatrices(parents.data(), locals.data(), simdResults.data(), 7);
+    MultiplyMatricesScalar(parents.data(), locals.data(), scalarResults.data(), 7);
+    for (int i = 0; i < 7; i++)
+    {
+        for (int j = 0; j < 16; j++)
+        {
+            assert(simdResults[i].data[j] == scalarResults[i].data[j]);
+        }
+    }
+    std::cout << "Batched SIMD multiply test passed!" << std::endl;
+
+    std::cout << "All Skeleton Instance Pool tests passed!" << std::endl;
+}
+
 void TestAnimationBlending()
 {
     std::cout << "\n=== ANIMATION BLENDING TESTS ===" << std::endl;
@@ -235,9 +607,432 @@ void TestAnimationBlending()
     assert(std::abs(result.boneTransforms[0].position.x - 1.3f) < 0.001f);
     std::cout << "  PASSED" << std::endl;
 
+    std::cout << "\nTest 10: Caller-provided output pose" << std::endl;
+    Pose output;
+    BlendPoses(poses, weights, output);
+    const Transform* outputStorage = output.boneTransforms.data();
+    BlendPoses(poses, weights, output);
+    assert(output.boneTransforms.data() == outputStorage); // Storage reused, no reallocation
+    assert(std::abs(output.boneTransforms[2].position.x - result.boneTransforms[2].position.x) < 0.0001f);
+    std::cout << "  PASSED" << std::endl;
+
+    std::cout << "\nTest 11: SoA pose blending" << std::endl;
+    std::vector<PoseSoA> posesSoA(3);
+    ToPoseSoA(idle, posesSoA[0]);
+    ToPoseSoA(walk, posesSoA[1]);
+    ToPoseSoA(run, posesSoA[2]);
+    PoseSoA outputSoA;
+    BlendPoses(posesSoA, weights, outputSoA);
+    Pose fromSoA;
+    ToPose(outputSoA, fromSoA);
+    assert(fromSoA.boneTransforms.size() == 3);
+    assert(std::abs(fromSoA.boneTransforms[1].position.y - 1.3f) < 0.001f);
+    assert(std::abs(fromSoA.boneTransforms[1].rotation.y - result.boneTransforms[1].rotation.y) < 0.0001f);
+    std::cout << "  PASSED" << std::endl;
+
+    std::cout << "\nTest 12: Hemisphere-corrected rotation blending" << std::endl;
+    Quaternion yaw = Quaternion::FromAxisAngle(Vector3(0, 1, 0), 0.5f);
+    Pose positive(1, Transform(Vector3(), yaw, Vector3(1, 1, 1)));
+    Pose negative(1, Transform(Vector3(), yaw * -1.0f, Vector3(1, 1, 1)));
+    poses = { positive, negative };
+    weights = { 0.5f, 0.5f };
+    result = BlendPoses(poses, weights);
+    assert(std::abs(std::abs(Dot(result.boneTransforms[0].rotation, yaw)) - 1.0f) < 0.0001f); // Same rotation, unit length
+    std::cout << "  PASSED" << std::endl;
+
+    std::cout << "\nTest 13: Nlerp, Slerp and batched approximate slerp" << std::endl;
+    Quaternion from = Quaternion::FromAxisAngle(Vector3(0, 0, 1), 0.0f);
+    Quaternion to = Quaternion::FromAxisAngle(Vector3(0, 0, 1), 2.0f) * -1.0f;
+    Quaternion halfway = Quaternion::FromAxisAngle(Vector3(0, 0, 1), 1.0f);
+    assert(std::abs(Dot(Slerp(from, to, 0.5f), halfway) - 1.0f) < 0.0001f);
+    assert(std::abs(Dot(Nlerp(from, to, 0.5f), halfway) - 1.0f) < 0.0001f);
+
+    std::vector<Quaternion> froms(6, from), tos(6, to), batched(6);
+    SlerpBatch(froms.data(), tos.data(), 0.3f, batched.data(), 6);
+    Quaternion exact = Slerp(from, to, 0.3f);
+    for (int i = 0; i < 6; i++)
+    {
+        assert(std::abs(Dot(batched[i], exact)) > 0.99999f);
+    }
+
+    // Lanes that interpolate to a zero quaternion come out as the identity, like Normalize, never NaN
+    Quaternion zero(0.0f, 0.0f, 0.0f, 0.0f);
+    std::vector<Quaternion> zeros(4, zero), guarded(4);
+    SlerpBatch(zeros.data(), zeros.data(), 0.5f, guarded.data(), 4);
+    SlerpBatch(froms.data(), zeros.data(), 1.0f, guarded.data() + 2, 2);
+    for (int i = 0; i < 4; i++)
+    {
+        assert(guarded[i].x == 0.0f && guarded[i].y == 0.0f && guarded[i].z == 0.0f && guarded[i].w == 1.0f);
+    }
+    std::cout << "  PASSED" << std::endl;
+
+    std::cout << "\nTest 14: Bone masks from skeleton subtrees" << std::endl;
+    // 0 Hips -> 1 Spine -> 2 Head, 0 Hips -> 3 Leg, 1 Spine -> 4 Arm
+    Skeleton body;
+    body.AddBone("Hips", -1, Transform());
+    body.AddBone("Spine", 0, Transform());
+    body.AddBone("Head", 1, Transform());
+    body.AddBone("Leg", 0, Transform());
+    body.AddBone("Arm", 1, Transform());
+    BoneMask upperBody = CreateBoneMask(body, 1);
+    upperBody.SetBoneWeight(2, 0.5f);
+    assert(upperBody.weights[0] == 0.0f && upperBody.weights[1] == 1.0f && upperBody.weights[3] == 0.0f && upperBody.weights[4] == 1.0f);
+    assert(upperBody.ranges.size() == 2 && upperBody.ranges[0].begin == 1 && upperBody.ranges[0].end == 3 && upperBody.ranges[1].begin == 4);
+
+    // A root added as its own parent and a parent cycle are roots and leaves, not endless chains
+    Skeleton selfParented;
+    selfParented.AddBone("Root", 0, Transform());
+    selfParented.AddBone("Spine", 0, Transform());
+    selfParented.AddBone("Loop", 3, Transform());
+    selfParented.AddBone("Back", 2, Transform());
+    BoneMask spineMask = CreateBoneMask(selfParented, 1);
+    assert(spineMask.weights[0] == 0.0f && spineMask.weights[1] == 1.0f && spineMask.weights[2] == 0.0f && spineMask.weights[3] == 0.0f);
+    BoneMask rootMask = CreateBoneMask(selfParented, 0);
+    assert(rootMask.weights[0] == 1.0f && rootMask.weights[1] == 1.0f);
+    std::cout << "  PASSED" << std::endl;
+
+    std::cout << "\nTest 15: Masked override and additive layers" << std::endl;
+    Quaternion aimRotation = Quaternion::FromAxisAngle(Vector3(0, 1, 0), 1.0f);
+    Pose base(5, Transform(Vector3(0, 1, 0), Quaternion(), Vector3(1, 1, 1)));
+    Pose aim(5, Transform(Vector3(0, 3, 0), aimRotation, Vector3(1, 1, 1)));
+    Pose layered = base;
+    BlendPoseLayer(layered, aim, 1.0f, upperBody);
+    assert(layered.boneTransforms[0].position.y == 1.0f && layered.boneTransforms[3].position.y == 1.0f);
+    assert(layered.boneTransforms[1].position.y == 3.0f && std::abs(layered.boneTransforms[2].position.y - 2.0f) < 0.0001f);
+    assert(Dot(layered.boneTransforms[4].rotation, aimRotation) > 0.99999f);
+
+    // Delta against a reference, added back onto a different base pose
+    Quaternion flinch = Quaternion::FromAxisAngle(Vector3(1, 0, 0), 0.4f);
+    Pose reference(5, Transform(Vector3(0, 1, 0), Quaternion(), Vector3(1, 1, 1)));
+    Pose hit(5, Transform(Vector3(0, 1.5f, 0), flinch, Vector3(1, 1, 1)));
+    Pose delta;
+    MakeAdditivePose(hit, reference, delta);
+    Pose additive = aim;
+    AddAdditivePose(additive, delta, 1.0f, upperBody);
+    assert(additive.boneTransforms[0].position.y == 3.0f && Dot(additive.boneTransforms[3].rotation, aimRotation) > 0.99999f);
+    assert(std::abs(additive.boneTransforms[1].position.y - 3.5f) < 0.0001f);
+    assert(Dot(additive.boneTransforms[1].rotation, aimRotation * flinch) > 0.99999f);
+    assert(std::abs(additive.boneTransforms[2].position.y - 3.25f) < 0.0001f);
+
+    Pose applied;
+    ApplyAdditivePose(aim, hit, reference, 1.0f, upperBody, applied);
+    for (int i = 0; i < 5; i++)
+    {
+        assert(std::abs(applied.boneTransforms[i].position.y - additive.boneTransforms[i].position.y) < 0.0001f);
+        assert(Dot(applied.boneTransforms[i].rotation, additive.boneTransforms[i].rotation) > 0.99999f);
+    }
+    std::cout << "  PASSED" << std::endl;
+
     std::cout << "All Animation Blending tests passed!" << std::endl;
 }
 
+void TestAnimationClip()
+{
+    std::cout << "\n=== ANIMATION CLIP TESTS ===" << std::endl;
+
+    // Bone 0 never moves, bone 1 turns 90 degrees around Z and slides along X over 2 frames
+    std::vector<Pose> frames;
+    for (int frame = 0; frame < 3; frame++)
+    {
+        Pose pose(2, Transform());
+        pose.boneTransforms[0].position = Vector3(0, 1, 0);
+        pose.boneTransforms[1].position = Vector3(frame * 1.0f, 0, 0);
+        pose.boneTransforms[1].rotation = Quaternion::FromAxisAngle(Vector3(0, 0, 1), frame * 3.14159f / 4.0f);
+        frames.push_back(pose);
+    }
+
+    AnimationClip clip = CreateAnimationClip("Turn", 2.0f, frames);
+    assert(clip.GetBoneCount() == 2);
+    assert(std::abs(clip.duration - 1.0f) < 0.0001f);
+    assert(clip.animatedPositionCount == 1 && clip.animatedRotationCount == 1 && clip.animatedScaleCount == 0);
+    assert(clip.positionKeys.size() == 3 && clip.constantScales.size() == 2);
+    std::cout << "Constant track collapsing test passed!" << std::endl;
+
+    // Smallest-three round trip
+    Quaternion original = Normalize(Quaternion(0.1f, -0.7f, 0.3f, -0.6f));
+    Quaternion decoded = DecompressQuaternion(CompressQuaternion(original));
+    assert(std::abs(Dot(original, decoded)) > 0.99999f);
+    std::cout << "Quaternion compression test passed!" << std::endl;
+
+    Pose sampled;
+    SampleAnimationClip(clip, 0.75f, sampled);
+    Quaternion expected = Quaternion::FromAxisAngle(Vector3(0, 0, 1), 1.5f * 3.14159f / 4.0f);
+    assert(sampled.boneTransforms.size() == 2);
+    assert(std::abs(sampled.boneTransforms[1].position.x - 1.5f) < 0.001f);
+    assert(std::abs(Dot(sampled.boneTransforms[1].rotation, expected)) > 0.9999f);
+    assert(sampled.boneTransforms[0].position.y == 1.0f);
+    std::cout << "Sampling test passed!" << std::endl;
+
+    // Sampling past the end clamps to the last key
+    SampleAnimationClip(clip, 5.0f, sampled);
+    assert(std::abs(sampled.boneTransforms[1].position.x - 2.0f) < 0.001f);
+    std::cout << "Clamped sampling test passed!" << std::endl;
+
+    // A 1 degree oscillation is real motion, not a constant track
+    std::vector<Pose> swayFrames;
+    for (int frame = 0; frame < 8; frame++)
+    {
+        Pose pose(1, Transform());
+        pose.boneTransforms[0].rotation = Quaternion::FromAxisAngle(Vector3(1, 0, 0), 0.01745f * std::sin(frame * 0.785f));
+        swayFrames.push_back(pose);
+    }
+    AnimationClip sway = CreateAnimationClip("Sway", 8.0f, swayFrames);
+    assert(sway.animatedRotationCount == 1);
+
+    // Rotations within the angular tolerance still collapse
+    AnimationClip still = CreateAnimationClip("Still", 8.0f, swayFrames, 0.0001f, -1, 0.02f);
+    assert(still.animatedRotationCount == 0);
+    std::cout << "Rotation tolerance test passed!" << std::endl;
+
+    // Root motion: the root walks 1 m/s along +Z while turning a quarter turn per second
+    std::vector<Pose> walkFrames;
+    for (int frame = 0; frame <= 30; frame++)
+    {
+        float t = frame / 30.0f;
+        Pose pose(2, Transform());
+        pose.boneTransforms[0].position = Vector3(0.0f, 1.0f + 0.05f * std::sin(6.28318f * t), t);
+        pose.boneTransforms[0].rotation = Quaternion::FromAxisAngle(Vector3(0, 1, 0), 1.5707963f * t);
+        walkFrames.push_back(pose);
+    }
+
+    AnimationClip turningWalk = CreateAnimationClip("TurningWalk", 30.0f, walkFrames, 0.0001f, 0);
+    assert(turningWalk.rootMotionKeys.size() == 31);
+    SampleAnimationClip(turningWalk, 0.5f, sampled);
+    assert(std::abs(sampled.boneTransforms[0].position.z) < 0.0001f); // In place, vertical bob kept
+    assert(std::abs(sampled.boneTransforms[0].position.y - 1.0f) < 0.001f);
+    assert(std::abs(sampled.boneTransforms[0].rotation.w - 1.0f) < 0.0001f);
+
+    RootMotion halfCycle = GetRootMotion(turningWalk, 0.0f, 0.5f);
+    assert(Length(halfCycle.translation - Vector3(0.0f, 0.0f, 0.5f)) < 0.0001f);
+    assert(std::abs(halfCycle.yaw - 0.7853982f) < 0.0001f);
+
+    // Across the loop boundary: the end of one cycle then the start of the next, in the turned frame
+    RootMotion acrossLoop = GetRootMotion(turningWalk, 0.75f, 1.25f);
+    RootMotion expectedAcross = Combine(Inverse(GetRootMotion(turningWalk, 0.0f, 0.75f)), Combine(GetRootMotion(turningWalk, 0.0f, 1.0f), GetRootMotion(turningWalk, 0.0f, 0.25f)));
+    assert(Length(acrossLoop.translation - expectedAcross.translation) < 0.0001f);
+    assert(std::abs(acrossLoop.yaw - 0.7853982f) < 0.0001f);
+
+    // Four quarter turns close the square
+    RootMotion fourCycles = GetRootMotion(turningWalk, 0.0f, 4.0f);
+    assert(Length(fourCycles.translation) < 0.001f);
+    assert(std::abs(fourCycles.yaw - 6.2831853f) < 0.001f);
+
+    // Whole cycles are composed in logarithmic time, even past the range where a float counter stops increasing
+    RootMotion manyCycles = GetRootMotion(turningWalk, 0.0f, 1001.0f);
+    assert(Length(manyCycles.translation - GetRootMotion(turningWalk, 0.0f, 1.0f).translation) < 0.01f); // 250 closed squares, then one cycle
+    RootMotion farCycles = GetRootMotion(turningWalk, 0.0f, 33554432.0f);
+    assert(std::isfinite(farCycles.translation.x) && std::isfinite(farCycles.yaw));
+
+    RootMotion backwards = GetRootMotion(turningWalk, 0.5f, 0.0f);
+    assert(Length(Combine(halfCycle, backwards).translation) < 0.0001f);
+
+    // Integrating per-frame deltas lands on the window query
+    RootMotionAccumulator accumulator;
+    for (int frame = 0; frame < 75; frame++)
+    {
+        accumulator.Apply(GetRootMotion(turningWalk, frame / 30.0f, (frame + 1) / 30.0f));
+    }
+    RootMotion window = GetRootMotion(turningWalk, 0.0f, 2.5f);
+    assert(Length(accumulator.position - window.translation) < 0.001f);
+    assert(std::abs(std::remainder(accumulator.yaw - window.yaw, 6.2831853f)) < 0.001f);
+    assert(GetRootMotion(clip, 0.0f, 1.0f).translation.x == 0.0f); // No track, no motion
+    std::cout << "Root motion test passed!" << std::endl;
+
+    std::cout << "All Animation Clip tests passed!" << std::endl;
+}
+
+void TestAnimationFile()
+{
+    std::cout << "\n=== ANIMATION FILE TESTS ===" << std::endl;
+
+    Skeleton skeleton;
+    int root = skeleton.AddBone("Root", -1, Transform());
+    skeleton.AddBone("Arm", root, Transform(Vector3(1, 0, 0), Quaternion(), Vector3(1, 1, 1)));
+
+    std::vector<Pose> frames;
+    for (int frame = 0; frame < 4; frame++)
+    {
+        Pose pose(2, Transform());
+        pose.boneTransforms[1].rotation = Quaternion::FromAxisAngle(Vector3(0, 1, 0), frame * 0.2f);
+        frames.push_back(pose);
+    }
+
+    std::vector<Pose> strideFrames = frames;
+    for (int frame = 0; frame < 4; frame++)
+    {
+        strideFrames[frame].boneTransforms[0].position = Vector3(0, 0, frame * 0.1f);
+    }
+
+    std::vector<AnimationClip> clips = { CreateAnimationClip("Wave", 30.0f, frames), CreateAnimationClip("Stride", 30.0f, strideFrames, 0.0001f, root) };
+    const char* path = "animation_file_test.bin";
+    bool written = WriteAnimationFile(path, skeleton, clips);
+    assert(written);
+
+    AnimationFile file;
+    bool opened = file.Open(path);
+    assert(opened);
+    assert(file.GetClipCount() == 2);
+    assert(file.FindClip("Wave") == 0);
+    assert(file.FindClip("Missing") == -1);
+
+    SkeletonView skeletonView = file.GetSkeleton();
+    assert(skeletonView.boneCount == 2);
+    assert(std::string(skeletonView.GetBoneName(1)) == "Arm");
+    assert(skeletonView.parentIndices[1] == root);
+    assert(skeletonView.bindPose[1].position.x == 1.0f);
+    std::cout << "Skeleton view test passed!" << std::endl;
+
+    // Sampling from the mapped pages must match the in-memory clip exactly
+    Pose fromMemory, fromFile;
+    SampleAnimationClip(clips[0], 0.05f, fromMemory);
+    SampleAnimationClip(file.GetClip(0), 0.05f, fromFile);
+    assert(fromFile.boneTransforms.size() == 2);
+    assert(fromFile.boneTransforms[1].rotation.y == fromMemory.boneTransforms[1].rotation.y);
+    assert(file.GetClip(0).rootMotionKeys == nullptr);
+    assert(file.GetClip(1).rootMotionKeys != nullptr);
+    assert(GetRootMotion(file.GetClip(1), 0.0f, 0.15f).translation.z == GetRootMotion(clips[1], 0.0f, 0.15f).translation.z);
+    std::cout << "Mapped sampling test passed!" << std::endl;
+
+    Skeleton loaded;
+    BuildSkeleton(skeletonView, loaded);
+    assert(loaded.GetBoneCount() == 2 && loaded.GetParentIndex(1) == root);
+    std::cout << "Skeleton rebuild test passed!" << std::endl;
+
+    file.Close();
+
+    // Corrupted copies must be rejected at Open, before anything samples them
+    std::vector<unsigned char> bytes;
+    FILE* source = std::fopen(path, "rb");
+    for (int c = std::fgetc(source); c != EOF; c = std::fgetc(source))
+    {
+        bytes.push_back((unsigned char)c);
+    }
+    std::fclose(source);
+
+    AnimationFileHeader header;
+    AnimationFileClip clipEntry;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    std::memcpy(&clipEntry, &bytes[header.clipTableOffset], sizeof(clipEntry));
+
+    auto opensCorrupted = [&](size_t offset, const void* value, size_t valueSize)
+    {
+        std::vector<unsigned char> corrupted = bytes;
+        std::memcpy(&corrupted[offset], value, valueSize);
+
+        const char* corruptedPath = "animation_file_corrupted.bin";
+        FILE* output = std::fopen(corruptedPath, "wb");
+        std::fwrite(corrupted.data(), 1, corrupted.size(), output);
+        std::fclose(output);
+
+        AnimationFile corruptedFile;
+        bool result = corruptedFile.Open(corruptedPath);
+        corruptedFile.Close();
+        std::remove(corruptedPath);
+        return result;
+    };
+
+    // Unmodified copy opens, so each rejection below is due to its one corrupted field
+    uint32_t magic = AnimationFileMagic;
+    assert(opensCorrupted(0, &magic, sizeof(magic)));
+
+    uint16_t badIndex = 999;
+    assert(!opensCorrupted(clipEntry.boneTracksOffset + sizeof(BoneTrack) + offsetof(BoneTrack, rotationIndex), &badIndex, sizeof(badIndex)));
+
+    int32_t forwardParent = 1;
+    assert(!opensCorrupted(header.parentIndicesOffset, &forwardParent, sizeof(forwardParent)));
+
+    float badRate = -30.0f;
+    assert(!opensCorrupted(header.clipTableOffset + offsetof(AnimationFileClip, sampleRate), &badRate, sizeof(badRate)));
+    float badDuration = NAN;
+    assert(!opensCorrupted(header.clipTableOffset + offsetof(AnimationFileClip, duration), &badDuration, sizeof(badDuration)));
+    std::cout << "Corrupted file test passed!" << std::endl;
+
+    std::remove(path);
+    bool reopened = file.Open(path);
+    assert(!reopened);
+    std::cout << "All Animation File tests passed!" << std::endl;
+}
+
+void TestAnimationGraph()
+{
+    std::cout << "\n=== ANIMATION GRAPH TESTS ===" << std::endl;
+
+    // Constant two-bone clips told apart by the root X position
+    auto makeClip = [](const std::string& name, float x)
+    {
+        Pose pose(2, Transform());
+        pose.boneTransforms[0].position = Vector3(x, 0, 0);
+        return CreateAnimationClip(name, 30.0f, { pose, pose });
+    };
+    AnimationClip idle = makeClip("Idle", 0.0f);
+    AnimationClip walk = makeClip("Walk", 1.0f);
+    AnimationClip run = makeClip("Run", 3.0f);
+    AnimationClip jump = makeClip("Jump", 10.0f);
+    AnimationClip lean = makeClip("Lean", 2.0f);
+    Pose reference(2, Transform());
+
+    // State machine over a speed blend tree, with an additive lean layer on top
+    AnimationGraph graph;
+    int speed = graph.AddParameter("speed");
+    int leanWeight = graph.AddParameter("lean");
+    int locomotion = graph.AddBlend1D(speed, { { 2.0f, graph.AddClip(&run) }, { 0.0f, graph.AddClip(&idle) }, { 1.0f, graph.AddClip(&walk) } });
+    int jumpClip = graph.AddClip(&jump);
+    int states = graph.AddStateMachine(0, { locomotion, locomotion, locomotion, jumpClip });
+    int layered = graph.AddAdditive(states, graph.AddClip(&lean), &reference, leanWeight);
+    assert(locomotion >= 0 && states >= 0 && layered >= 0);
+    assert(graph.AddBlend1D(speed, { { 0.0f, 42 } }) == -1);
+    graph.SetRoot(layered);
+
+    StateMachine stateMachine(Idle);
+    stateMachine.isGrounded = true;
+
+    AnimationGraphContext context;
+    graph.InitializeContext(context);
+    context.stateMachines[0] = &stateMachine.getInstance();
+    context.parameters[speed] = 1.5f;
+
+    Pose pose;
+    assert(graph.Evaluate(context, pose));
+    assert(std::abs(pose.boneTransforms[0].position.x - 2.0f) < 0.001f);
+    assert(context.sampledClipCount == 2 && context.blendedPoseCount == 2);
+    std::cout << "Nested blend test passed!" << std::endl;
+
+    // Jump cross-fade: jump and the locomotion subtree blend by the transition weight
+    stateMachine.isGrounded = false;
+    stateMachine.update(0.0f);
+    stateMachine.update(0.05f);
+    float jumpWeight = stateMachine.getTransitionWeight();
+    assert(graph.Evaluate(context, pose));
+    assert(std::abs(pose.boneTransforms[0].position.x - (jumpWeight * 10.0f + (1.0f - jumpWeight) * 2.0f)) < 0.001f);
+    assert(context.sampledClipCount == 3);
+    std::cout << "State machine node test passed!" << std::endl;
+
+    // Once the transition ends the whole locomotion subtree is pruned, even though speed still selects two clips
+    stateMachine.update(1.0f);
+    context.parameters[leanWeight] = 0.5f;
+    assert(graph.Evaluate(context, pose));
+    assert(std::abs(pose.boneTransforms[0].position.x - 11.0f) < 0.001f);
+    assert(context.sampledClipCount == 2 && context.blendedPoseCount == 0);
+    std::cout << "Weight pruning and additive layer test passed!" << std::endl;
+
+    // Masked override layer: only the root bone follows the overlay
+    BoneMask rootOnly(2, 0.0f);
+    rootOnly.SetBoneWeight(0, 1.0f);
+    AnimationGraph layerGraph;
+    int overlayWeight = layerGraph.AddParameter("overlay");
+    layerGraph.SetRoot(layerGraph.AddLayer(layerGraph.AddClip(&walk), layerGraph.AddClip(&jump), &rootOnly, overlayWeight));
+    AnimationGraphContext layerContext;
+    layerGraph.InitializeContext(layerContext);
+    layerContext.parameters[overlayWeight] = 0.25f;
+    assert(layerGraph.Evaluate(layerContext, pose));
+    assert(std::abs(pose.boneTransforms[0].position.x - 3.25f) < 0.001f && pose.boneTransforms[1].position.x == 0.0f);
+    layerContext.parameters[overlayWeight] = 0.0f;
+    assert(layerGraph.Evaluate(layerContext, pose) && layerContext.sampledClipCount == 1);
+    std::cout << "Masked layer node test passed!" << std::endl;
+
+    std::cout << "All Animation Graph tests passed!" << std::endl;
+}
+
 void TestIKSolver()
 {
     std::cout << "\n=== IK SOLVER TESTS ===" << std::endl;
@@ -335,8 +1130,962 @@ void TestIKSolver()
     std::cout << "  3D target reached successfully" << std::endl;
     std::cout << "  PASSED" << std::endl;
 
+    // ============================================
+    // Test 7: 3D solve with pole vector
+    // ============================================
+    std::cout << "\nTest 7: 3D solve with pole vector" << std::endl;
+    Vector3 pole7(0.0f, 0.0f, 1.0f);
+    IKResult3D result7 = SolveTwoBoneIK(start6, target6, pole7, armChain);
+
+    assert(result7.isReachable == true);
+    assert(Length(result7.endPosition - target6) < 0.0001f);
+    assert(std::abs(Length(result7.elbowPosition - start6) - armChain.upperLength) < 0.0001f);
+    assert(std::abs(Length(result7.endPosition - result7.elbowPosition) - armChain.lowerLength) < 0.0001f);
+    assert(Dot(result7.elbowPosition, pole7) > 0.0f); // Bends toward the pole
+    // Bone rotations take the +X rest axis onto each bone
+    assert(Length(Rotate(result7.upperRotation, Vector3(armChain.upperLength, 0, 0)) - result7.elbowPosition) < 0.0001f);
+    assert(Length(Rotate(result7.lowerRotation, Vector3(armChain.lowerLength, 0, 0)) - (result7.endPosition - result7.elbowPosition)) < 0.0001f);
+    // Same elbow angle as the planar solver
+    float elbowAngle7 = std::acos(Clamp(Dot(Normalize(start6 - result7.elbowPosition), Normalize(result7.endPosition - result7.elbowPosition)), -1.0f, 1.0f));
+    assert(std::abs(elbowAngle7 - result6.elbowAngle) < 0.001f);
+
+    IKResult3D unreachable7 = SolveTwoBoneIK(start2, target2, pole7, armChain);
+    assert(unreachable7.isReachable == false);
+    assert(Length(unreachable7.endPosition - Vector3(0.55f, 0.0f, 0.0f)) < 0.0001f); // Straightened toward the target
+    std::cout << "  PASSED" << std::endl;
+
+    // ============================================
+    // Test 8: Batched SIMD solve matches the scalar one
+    // ============================================
+    std::cout << "\nTest 8: Batched solve" << std::endl;
+    IKBatch batch;
+    batch.Resize(11);
+    for (int i = 0; i < 11; i++)
+    {
+        Vector3 target(0.05f * i - 0.2f, 0.3f - 0.04f * i, 0.1f * (i % 3));
+        batch.SetChain(i, Vector3(0.0f, 0.1f * i, 0.0f), target + Vector3(0.0f, 0.1f * i, 0.0f), Vector3(0.0f, 0.1f * i, i % 2 == 0 ? 1.0f : -1.0f), armChain);
+    }
+    batch.SetChain(5, Vector3(), Vector3(0.0f, 0.2f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), armChain); // Pole on the target line
+    batch.SetChain(6, Vector3(), Vector3(), Vector3(0.0f, 1.0f, 0.0f), armChain); // Target on the start
+    batch.SetChain(7, Vector3(), Vector3(-1.0f, 0.0f, 0.0f), Vector3(0.0f, -1.0f, -1.0f), armChain); // -X target, rotation w near zero
+    SolveTwoBoneIKBatch(batch);
+
+    Vector3 flippedYAxis = Rotate(batch.GetResult(7).upperRotation, Vector3(0.0f, 1.0f, 0.0f));
+    assert(Length(flippedYAxis - Vector3(0.0f, -0.7071f, -0.7071f)) < 0.001f);
+
+    for (int i = 0; i < 11; i++)
+    {
+        Vector3 start(batch.startX[i], batch.startY[i], batch.startZ[i]);
+        Vector3 target(batch.targetX[i], batch.targetY[i], batch.targetZ[i]);
+        Vector3 pole(batch.poleX[i], batch.poleY[i], batch.poleZ[i]);
+        IKResult3D expected = SolveTwoBoneIK(start, target, pole, armChain);
+        IKResult3D batched = batch.GetResult(i);
+
+        assert(batched.isReachable == expected.isReachable);
+        assert(Length(batched.elbowPosition - expected.elbowPosition) < 0.001f);
+        assert(Length(batched.endPosition - expected.endPosition) < 0.001f);
+        assert(std::abs(Dot(batched.upperRotation, expected.upperRotation)) > 0.9999f);
+        assert(std::abs(Dot(batched.lowerRotation, expected.lowerRotation)) > 0.9999f);
+    }
+    std::cout << "  PASSED" << std::endl;
+
+    // ============================================
+    // Test 9: FABRIK and CCD on a skeleton chain
+    // ============================================
+    std::cout << "\nTest 9: FABRIK and CCD on a skeleton chain" << std::endl;
+    Skeleton tail;
+    int tailBones[6];
+    tailBones[0] = tail.AddBone("Hips", -1, Transform(Vector3(0.0f, 1.0f, 0.0f), Quaternion(), Vector3(1.0f, 1.0f, 1.0f)));
+    for (int i = 1; i < 6; i++)
+    {
+        tailBones[i] = tail.AddBone("Tail" + std::to_string(i), tailBones[i - 1], Transform(Vector3(0.2f, 0.0f, 0.0f), Quaternion(), Vector3(1.0f, 1.0f, 1.0f)));
+    }
+
+    IKBoneChain invalidChain;
+    assert(BuildIKBoneChain(tail, tailBones[3], tailBones[1], invalidChain) == false); // End above start
+
+    IKIterativeSettings settings9;
+    settings9.maxIterations = 20;
+    settings9.tolerance = 0.0005f;
+    Vector3 target9(0.3f, 1.5f, 0.2f);
+
+    for (int solver = 0; solver < 2; solver++)
+    {
+        for (int i = 1; i < 6; i++)
+        {
+            tail.SetLocalTransform(tailBones[i], Transform(Vector3(0.2f, 0.0f, 0.0f), Quaternion(), Vector3(1.0f, 1.0f, 1.0f)));
+        }
+
+        IKBoneChain chain9;
+        assert(BuildIKBoneChain(tail, tailBones[1], tailBones[5], chain9));
+        assert(chain9.bones.size() == 5);
+
+        IKIterativeResult result9 = solver == 0 ? SolveFABRIK(tail, chain9, target9, settings9) : SolveCCD(tail, chain9, target9, settings9);
+        tail.UpdateWorldPoses();
+
+        assert(result9.isReachable);
+        assert(result9.iterations > 0 && result9.iterations <= settings9.maxIterations);
+        assert(Length(tail.GetWorldPose(tailBones[5]).position - target9) < 0.005f);
+        assert(Length(tail.GetWorldPose(tailBones[1]).position - Vector3(0.2f, 1.0f, 0.0f)) < 0.0001f); // Root stays put
+        for (int i = 2; i < 6; i++)
+        {
+            float boneLength = Length(tail.GetWorldPose(tailBones[i]).position - tail.GetWorldPose(tailBones[i - 1]).position);
+            assert(std::abs(boneLength - 0.2f) < 0.0001f);
+        }
+
+        // Warm start: the previous solution already reaches the target, even though the animation reset the pose
+        assert(result9.error <= settings9.tolerance);
+        tail.SetLocalTransform(tailBones[2], Transform(Vector3(0.2f, 0.0f, 0.0f), Quaternion(), Vector3(1.0f, 1.0f, 1.0f)));
+        IKIterativeResult warm9 = solver == 0 ? SolveFABRIK(tail, chain9, target9, settings9) : SolveCCD(tail, chain9, target9, settings9);
+        assert(warm9.iterations == 0);
+
+        // Out of reach: straightened toward the target
+        IKIterativeResult far9 = solver == 0 ? SolveFABRIK(tail, chain9, Vector3(5.0f, 1.0f, 0.0f), settings9) : SolveCCD(tail, chain9, Vector3(5.0f, 1.0f, 0.0f), settings9);
+        tail.UpdateWorldPoses();
+        assert(far9.isReachable == false);
+        assert(std::abs(tail.GetWorldPose(tailBones[5]).position.x - 1.0f) < 0.01f);
+
+        std::cout << "  " << (solver == 0 ? "FABRIK" : "CCD") << ": " << result9.iterations << " iterations, error " << result9.error << std::endl;
+    }
+
+    // A root added as its own parent ends the chain walk, and an unrelated start bone is rejected
+    Skeleton selfParented;
+    int selfRoot = selfParented.AddBone("Root", 0, Transform(Vector3(0.0f, 1.0f, 0.0f), Quaternion(), Vector3(1.0f, 1.0f, 1.0f)));
+    int selfMiddle = selfParented.AddBone("Middle", selfRoot, Transform(Vector3(0.3f, 0.0f, 0.0f), Quaternion(), Vector3(1.0f, 1.0f, 1.0f)));
+    int selfEnd = selfParented.AddBone("End", selfMiddle, Transform(Vector3(0.3f, 0.0f, 0.0f), Quaternion(), Vector3(1.0f, 1.0f, 1.0f)));
+    int selfOther = selfParented.AddBone("Other", selfRoot, Transform());
+
+    IKBoneChain selfChain;
+    assert(BuildIKBoneChain(selfParented, selfOther, selfEnd, selfChain) == false);
+    assert(BuildIKBoneChain(selfParented, selfRoot, selfEnd, selfChain) && selfChain.bones.size() == 3);
+    IKIterativeResult selfResult = SolveFABRIK(selfParented, selfChain, Vector3(0.3f, 1.3f, 0.0f), settings9);
+    selfParented.UpdateWorldPoses();
+    assert(selfResult.isReachable);
+    assert(Length(selfParented.GetWorldPose(selfEnd).position - Vector3(0.3f, 1.3f, 0.0f)) < 0.005f);
+    std::cout << "  PASSED" << std::endl;
+
     std::cout << "\n=== ALL IK SOLVER TESTS PASSED ===" << std::endl;
 }
+
+void TestSkinning()
+{
+    std::cout << "\n=== SKINNING TESTS ===" << std::endl;
+
+    Skeleton skeleton;
+    Transform identity = Transform(Vector3(), Quaternion(), Vector3(1.0f, 1.0f, 1.0f));
+    int root = skeleton.AddBone("Root", -1, identity);
+    int forearm = skeleton.AddBone("Forearm", root, Transform(Vector3(1.0f, 0.0f, 0.0f), Quaternion(), Vector3(1.0f, 1.0f, 1.0f)));
+    skeleton.UpdateWorldPoses();
+
+    std::vector<Transform> inverseBindPose;
+    ComputeInverseBindPose(skeleton, inverseBindPose);
+
+    // Vertex 0 follows the root, 1 the forearm, 2 sits on the elbow split between both
+    SkinnedMesh mesh;
+    mesh.Resize(3, 4, skeleton.GetBoneCount());
+    mesh.bindVertices.SetVertex(0, Vector3(0.5f, 0.1f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
+    mesh.bindVertices.SetVertex(1, Vector3(1.5f, 0.1f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
+    mesh.bindVertices.SetVertex(2, Vector3(1.0f, 0.0f, 0.2f), Vector3(0.0f, 0.0f, 1.0f));
+    mesh.SetInfluence(0, 0, root, 1.0f);
+    mesh.SetInfluence(1, 0, forearm, 1.0f);
+    mesh.SetInfluence(2, 0, root, 1.0f);
+    mesh.SetInfluence(2, 1, forearm, 1.0f);
+    mesh.NormalizeWeights();
+    assert(std::abs(mesh.boneWeights[2] - 0.5f) < 0.0001f);
+
+    VertexStream skinned;
+    skinned.Resize(mesh.GetVertexCount());
+
+    // ============================================
+    // Test 1: Bind pose leaves the mesh unchanged
+    // ============================================
+    std::cout << "\nTest 1: Bind pose" << std::endl;
+    std::vector<Matrix3x4> palette;
+    std::vector<DualQuaternion> dualPalette;
+    BuildSkinningPalette(skeleton, inverseBindPose, palette);
+    BuildDualQuaternionPalette(skeleton, inverseBindPose, dualPalette);
+
+    for (int method = 0; method < 2; method++)
+    {
+        if (method == 0)
+        {
+            SkinVerticesLinear(mesh, palette.data(), 0, mesh.GetVertexCount(), skinned);
+        }
+        else
+        {
+            SkinVerticesDualQuaternion(mesh, dualPalette.data(), 0, mesh.GetVertexCount(), skinned);
+        }
+
+        for (int v = 0; v < mesh.GetVertexCount(); v++)
+        {
+            assert(Length(skinned.GetPosition(v) - mesh.bindVertices.GetPosition(v)) < 0.0001f);
+            assert(Length(skinned.GetNormal(v) - mesh.bindVertices.GetNormal(v)) < 0.0001f);
+        }
+    }
+    std::cout << "  PASSED" << std::endl;
+
+    // ============================================
+    // Test 2: Twisted forearm, linear vs dual quaternion
+    // ============================================
+    std::cout << "\nTest 2: Twisted forearm" << std::endl;
+    skeleton.SetLocalTransform(forearm, Transform(Vector3(1.0f, 0.0f, 0.0f), Quaternion::FromAxisAngle(Vector3(1.0f, 0.0f, 0.0f), 3.0f), Vector3(1.0f, 1.0f, 1.0f)));
+    skeleton.UpdateWorldPoses();
+    BuildSkinningPalette(skeleton, inverseBindPose, palette);
+    BuildDualQuaternionPalette(skeleton, inverseBindPose, dualPalette);
+
+    Vector3 expectedForearm = Vector3(1.0f, 0.0f, 0.0f) + Rotate(Quaternion::FromAxisAngle(Vector3(1.0f, 0.0f, 0.0f), 3.0f), Vector3(0.5f, 0.1f, 0.0f));
+
+    SkinVerticesLinear(mesh, palette.data(), 0, mesh.GetVertexCount(), skinned);
+    assert(Length(skinned.GetPosition(0) - Vector3(0.5f, 0.1f, 0.0f)) < 0.0001f);
+    assert(Length(skinned.GetPosition(1) - expectedForearm) < 0.0001f);
+    float linearRadius = Length(skinned.GetPosition(2) - Vector3(1.0f, 0.0f, 0.0f));
+
+    SkinVerticesDualQuaternion(mesh, dualPalette.data(), 0, mesh.GetVertexCount(), skinned);
+    assert(Length(skinned.GetPosition(1) - expectedForearm) < 0.0001f);
+    float dualRadius = Length(skinned.GetPosition(2) - Vector3(1.0f, 0.0f, 0.0f));
+    assert(std::abs(Length(skinned.GetNormal(2)) - 1.0f) < 0.0001f);
+
+    // Linear blending collapses the twisted elbow toward the bone (candy wrapper), dual quaternions keep its volume
+    assert(linearRadius < 0.05f);
+    assert(std::abs(dualRadius - 0.2f) < 0.0001f);
+    std::cout << "  Elbow radius: linear " << linearRadius << ", dual quaternion " << dualRadius << " (bind 0.2)" << std::endl;
+    std::cout << "  PASSED" << std::endl;
+
+    // ============================================
+    // Test 3: SIMD and scalar paths agree, any vertex range split
+    // ============================================
+    std::cout << "\nTest 3: SIMD blocks, scalar tails and parallel ranges" << std::endl;
+    JobSystem jobs(2);
+    for (int influences : { 4, 8, 3 })
+    {
+        SkinnedMesh crowdMesh;
+        crowdMesh.Resize(37, influences, 2);
+        for (int v = 0; v < 37; v++)
+        {
+            crowdMesh.bindVertices.SetVertex(v, Vector3(0.05f * v, 0.1f * (v % 5), -0.02f * v), Normalize(Vector3(1.0f, 0.1f * v, 0.5f)));
+            for (int i = 0; i < influences; i++)
+            {
+                crowdMesh.SetInfluence(v, i, (v + i) % 2, 1.0f + (v * 7 + i * 3) % 5);
+            }
+        }
+        crowdMesh.NormalizeWeights();
+
+        VertexStream whole, perVertex, parallel;
+        for (VertexStream* stream : { &whole, &perVertex, &parallel })
+        {
+            stream->Resize(37);
+        }
+
+        for (int method = 0; method < 2; method++)
+        {
+            auto skin = [&](int begin, int end, VertexStream& out)
+            {
+                if (method == 0)
+                {
+                    SkinVerticesLinear(crowdMesh, palette.data(), begin, end, out);
+                }
+                else
+                {
+                    SkinVerticesDualQuaternion(crowdMesh, dualPalette.data(), begin, end, out);
+                }
+            };
+
+            skin(0, 37, whole);
+            for (int v = 0; v < 37; v++)
+            {
+                skin(v, v + 1, perVertex);
+            }
+            jobs.ParallelFor(37, 6, [&](int begin, int end) { skin(begin, end, parallel); });
+
+            for (int v = 0; v < 37; v++)
+            {
+                assert(Length(whole.GetPosition(v) - perVertex.GetPosition(v)) < 0.0001f);
+                assert(Length(whole.GetNormal(v) - perVertex.GetNormal(v)) < 0.0001f);
+                assert(Length(whole.GetPosition(v) - parallel.GetPosition(v)) < 0.0001f);
+            }
+        }
+    }
+    std::cout << "  PASSED" << std::endl;
+
+    // ============================================
+    // Test 4: Non-uniform and mirrored bone scale, out-of-range bones
+    // ============================================
+    std::cout << "\nTest 4: Scaled normals and bone index checks" << std::endl;
+    Quaternion tilt = Quaternion::FromAxisAngle(Vector3(0.0f, 0.0f, 1.0f), 0.7f);
+    std::vector<Matrix3x4> scaledPalette = {
+        ToMatrix3x4(Transform(Vector3(0.0f, 1.0f, 0.0f), tilt, Vector3(3.0f, 1.0f, 0.5f))),
+        ToMatrix3x4(Transform(Vector3(), tilt, Vector3(-2.0f, 1.0f, 1.0f)))
+    };
+    Vector3 surfaceNormal = Normalize(Vector3(1.0f, 1.0f, 0.0f));
+    Vector3 surfaceTangent = Normalize(Vector3(1.0f, -1.0f, 0.0f));
+
+    for (int influences : { 4, 3 })
+    {
+        for (int bone = 0; bone < 2; bone++)
+        {
+            SkinnedMesh scaledMesh;
+            scaledMesh.Resize(5, influences, 2);
+            for (int v = 0; v < 5; v++)
+            {
+                scaledMesh.bindVertices.SetVertex(v, Vector3(0.1f * v, 0.0f, 0.0f), surfaceNormal);
+                scaledMesh.SetInfluence(v, 0, bone, 1.0f);
+            }
+
+            VertexStream scaledOut;
+            scaledOut.Resize(5);
+            SkinVerticesLinear(scaledMesh, scaledPalette.data(), 0, 5, scaledOut);
+
+            const float* m = scaledPalette[bone].data;
+            Vector3 tangent(m[0] * surfaceTangent.x + m[1] * surfaceTangent.y, m[4] * surfaceTangent.x + m[5] * surfaceTangent.y, m[8] * surfaceTangent.x + m[9] * surfaceTangent.y);
+            Vector3 normal(m[0] * surfaceNormal.x + m[1] * surfaceNormal.y, m[4] * surfaceNormal.x + m[5] * surfaceNormal.y, m[8] * surfaceNormal.x + m[9] * surfaceNormal.y);
+            for (int v = 0; v < 5; v++)
+            {
+                assert(std::abs(Dot(scaledOut.GetNormal(v), tangent)) < 0.0001f); // Still perpendicular to the deformed surface
+                assert(Dot(scaledOut.GetNormal(v), normal) > 0.0f); // Same side, mirrored or not
+                assert(std::abs(Length(scaledOut.GetNormal(v)) - 1.0f) < 0.0001f);
+            }
+        }
+    }
+
+    SkinnedMesh checkedMesh;
+    checkedMesh.Resize(1, 4, 2);
+    checkedMesh.SetInfluence(0, 0, 1, 1.0f);
+    checkedMesh.SetInfluence(0, 1, 2, 1.0f);
+    checkedMesh.SetInfluence(0, 2, -1, 1.0f);
+    checkedMesh.SetInfluence(0, 3, 70000, 1.0f);
+    assert(checkedMesh.boneIndices[0] == 1 && checkedMesh.boneWeights[0] == 1.0f);
+    for (int i = 1; i < 4; i++)
+    {
+        assert(checkedMesh.boneIndices[i] == 0 && checkedMesh.boneWeights[i] == 0.0f);
+    }
+    std::cout << "  PASSED" << std::endl;
+
+    std::cout << "\n=== ALL SKINNING TESTS PASSED ===" << std::endl;
+}
+
+void TestParallelUpdate()
+{
+    std::cout << "\n=== PARALLEL ANIMATION UPDATE TESTS ===" << std::endl;
+
+    JobSystem jobs(3);
+
+    // ParallelFor covers every index exactly once, including nested loops
+    std::vector<int> visits(1000, 0);
+    jobs.ParallelFor(10, 1, [&](int begin, int end)
+    {
+        for (int outer = begin; outer < end; outer++)
+        {
+            jobs.ParallelFor(100, 7, [&](int innerBegin, int innerEnd)
+            {
+                for (int inner = innerBegin; inner < innerEnd; inner++)
+                {
+                    visits[outer * 100 + inner]++;
+                }
+            });
+        }
+    });
+    for (int visit : visits)
+    {
+        assert(visit == 1);
+    }
+    std::cout << "Nested ParallelFor test passed!" << std::endl;
+
+    // Two clips on a branching 40-bone rig
+    const int BoneCount = 40;
+    std::vector<Pose> idleFrames, walkFrames;
+    for (int frame = 0; frame < 10; frame++)
+    {
+        Pose idlePose(BoneCount, Transform(Vector3(0, 0.1f, 0), Quaternion(), Vector3(1, 1, 1)));
+        Pose walkPose = idlePose;
+        for (int bone = 0; bone < BoneCount; bone++)
+        {
+            walkPose.boneTransforms[bone].rotation = Quaternion::FromAxisAngle(Vector3(1, 0, 0), 0.05f * frame + 0.01f * bone);
+        }
+        idleFrames.push_back(idlePose);
+        walkFrames.push_back(walkPose);
+    }
+    AnimationClip idle = CreateAnimationClip("Idle", 30.0f, idleFrames);
+    AnimationClip walk = CreateAnimationClip("Walk", 30.0f, walkFrames);
+
+    BlendTree1D blendTree;
+    blendTree.addAnimation(0.0f, &idle);
+    blendTree.addAnimation(3.0f, &walk);
+
+    const int CharacterCount = 16;
+    CharacterInstance character;
+    character.blendTree = &blendTree;
+    character.useIK = true;
+    character.ikRootBone = 1;
+    character.ikChain = { 0.3f, 0.25f };
+    character.ikTarget = Vector3(0.2f, 0.4f, 0.1f);
+
+    // Each run gets its own skeletons and state machines so it can be compared against the others
+    auto buildCharacters = [&](std::vector<Skeleton>& skeletons, std::vector<StateMachine>& stateMachines, std::vector<CharacterInstance>& characters)
+    {
+        skeletons = std::vector<Skeleton>(CharacterCount);
+        stateMachines = std::vector<StateMachine>(CharacterCount, StateMachine(Idle));
+        characters = std::vector<CharacterInstance>(CharacterCount, character);
+
+        for (int i = 0; i < CharacterCount; i++)
+        {
+            for (int bone = 0; bone < BoneCount; bone++)
+            {
+                int parent = bone == 0 ? -1 : (bone - 1) / 3;
+                skeletons[i].AddBone("Bone" + std::to_string(bone), parent, Transform());
+            }
+
+            characters[i].skeleton = &skeletons[i];
+            characters[i].stateMachine = &stateMachines[i];
+            characters[i].blendParameter = 0.2f * i;
+        }
+    };
+
+    std::vector<Skeleton> serialSkeletons;
+    std::vector<StateMachine> serialStateMachines;
+    std::vector<CharacterInstance> serialCharacters;
+    buildCharacters(serialSkeletons, serialStateMachines, serialCharacters);
+
+    for (int frame = 0; frame < 3; frame++)
+    {
+        for (CharacterInstance& serialCharacter : serialCharacters)
+        {
+            UpdateCharacter(serialCharacter, 1.0f / 30.0f);
+        }
+    }
+
+    AnimationUpdateSettings settings;
+    settings.subtreeSplitBoneCount = 32;
+    settings.maxSubtreeSpanBones = 8;
+
+    // Bit-identical to the single-threaded path with one, two and one-per-hardware-thread workers
+    for (int workerCount : { 1, 2, 0 })
+    {
+        JobSystem workers(workerCount);
+
+        std::vector<Skeleton> parallelSkeletons;
+        std::vector<StateMachine> parallelStateMachines;
+        std::vector<CharacterInstance> parallelCharacters;
+        buildCharacters(parallelSkeletons, parallelStateMachines, parallelCharacters);
+
+        for (int frame = 0; frame < 3; frame++)
+        {
+            UpdateCharacters(workers, parallelCharacters.data(), CharacterCount, 1.0f / 30.0f, settings);
+        }
+
+        for (int i = 0; i < CharacterCount; i++)
+        {
+            for (int bone = 0; bone < BoneCount; bone++)
+            {
+                Transform a = serialSkeletons[i].GetWorldPose(bone);
+                Transform b = parallelSkeletons[i].GetWorldPose(bone);
+                assert(a.position.x == b.position.x && a.position.y == b.position.y && a.position.z == b.position.z);
+                assert(a.rotation.x == b.rotation.x && a.rotation.y == b.rotation.y && a.rotation.z == b.rotation.z && a.rotation.w == b.rotation.w);
+            }
+            assert(serialCharacters[i].ikResult.elbowAngle == parallelCharacters[i].ikResult.elbowAngle);
+        }
+    }
+    std::cout << "Deterministic parallel update test passed!" << std::endl;
+
+    // Per-state blend trees: the source state is only sampled while the cross-fade runs
+    BlendTree1D idleTree, walkTree;
+    idleTree.addAnimation(0.0f, &idle);
+    walkTree.addAnimation(0.0f, &walk);
+
+    Skeleton fadeSkeleton;
+    for (int bone = 0; bone < BoneCount; bone++)
+    {
+        fadeSkeleton.AddBone("Bone" + std::to_string(bone), bone - 1, Transform());
+    }
+    StateMachine fadeStateMachine(Idle);
+    fadeStateMachine.isGrounded = true;
+
+    CharacterInstance fading;
+    fading.skeleton = &fadeSkeleton;
+    fading.stateMachine = &fadeStateMachine;
+    fading.stateBlendTrees = { &idleTree, &walkTree };
+
+    UpdateCharacter(fading, 0.1f);
+    fadeStateMachine.speed = 2.0f;
+    UpdateCharacter(fading, 0.1f);
+    Pose expected;
+    SampleAnimationClip(idle, std::fmod(fading.time, idle.duration), expected);
+    assert(fadeStateMachine.isTransitioning());
+    assert(Dot(fading.pose.boneTransforms[5].rotation, expected.boneTransforms[5].rotation) > 0.99999f);
+
+    UpdateCharacter(fading, 0.1f);
+    Quaternion halfway = fading.pose.boneTransforms[5].rotation;
+    SampleAnimationClip(walk, std::fmod(fading.time, walk.duration), expected);
+    assert(Dot(halfway, expected.boneTransforms[5].rotation) < 0.99999f);
+
+    UpdateCharacter(fading, 0.1f);
+    SampleAnimationClip(walk, std::fmod(fading.time, walk.duration), expected);
+    assert(!fadeStateMachine.isTransitioning());
+    assert(Dot(fading.pose.boneTransforms[5].rotation, expected.boneTransforms[5].rotation) > 0.99999f);
+    std::cout << "State cross-fade pose test passed!" << std::endl;
+
+    // 2D blend space: only clips with a nonzero weight are sampled
+    BlendSpace2D blendSpace;
+    blendSpace.addAnimation(0.0f, 0.0f, &idle);
+    blendSpace.addAnimation(1.0f, 0.0f, &walk);
+    blendSpace.addAnimation(0.0f, 1.0f, &walk);
+    blendSpace.addAnimation(1.0f, 1.0f, &idle);
+
+    CharacterInstance directional;
+    directional.skeleton = &fadeSkeleton;
+    directional.blendSpace = &blendSpace;
+    directional.blendParameter = 0.5f;
+    UpdateCharacter(directional, 0.1f);
+    assert(directional.sampledClipCount == 2);
+    directional.blendParameter = 0.0f;
+    UpdateCharacter(directional, 0.1f);
+    SampleAnimationClip(idle, std::fmod(directional.time, idle.duration), expected);
+    assert(directional.sampledClipCount == 1);
+    assert(Dot(directional.pose.boneTransforms[5].rotation, expected.boneTransforms[5].rotation) > 0.99999f);
+    std::cout << "Sparse blend space evaluation test passed!" << std::endl;
+
+    // Animation graph driven by the character's own state machine
+    AnimationGraph graph;
+    int speed = graph.AddParameter("speed");
+    int locomotion = graph.AddBlend1D(speed, { { 0.0f, graph.AddClip(&idle) }, { 3.0f, graph.AddClip(&walk) } });
+    graph.SetRoot(graph.AddStateMachine(0, { locomotion, locomotion, locomotion, graph.AddClip(&idle) }));
+
+    StateMachine graphStateMachine(Walk);
+    graphStateMachine.isGrounded = true;
+    graphStateMachine.speed = 3.0f;
+
+    CharacterInstance graphCharacter;
+    graphCharacter.skeleton = &fadeSkeleton;
+    graphCharacter.stateMachine = &graphStateMachine;
+    graphCharacter.graph = &graph;
+    graph.InitializeContext(graphCharacter.graphContext);
+    graphCharacter.graphContext.parameters[speed] = 3.0f;
+    UpdateCharacter(graphCharacter, 0.1f);
+    SampleAnimationClip(walk, std::fmod(graphCharacter.time, walk.duration), expected);
+    assert(graphCharacter.graphContext.sampledClipCount == 1);
+    assert(Dot(graphCharacter.pose.boneTransforms[5].rotation, expected.boneTransforms[5].rotation) > 0.99999f);
+    std::cout << "Character animation graph test passed!" << std::endl;
+
+    // LOD throttling: full evaluations every 3 frames, the frames in between interpolate the last two
+    CharacterInstance throttled;
+    throttled.skeleton = &fadeSkeleton;
+    throttled.blendTree = &walkTree;
+    throttled.lod.updateInterval = 3;
+
+    UpdateCharacter(throttled, 0.05f);
+    UpdateCharacter(throttled, 0.05f);
+    UpdateCharacter(throttled, 0.05f);
+    assert(std::abs(throttled.time - 0.05f) < 0.0001f); // Only the first frame evaluated
+    assert(std::abs(throttled.pendingDeltaTime - 0.1f) < 0.0001f);
+    SampleAnimationClip(walk, 0.05f, expected);
+    assert(Dot(throttled.pose.boneTransforms[5].rotation, expected.boneTransforms[5].rotation) > 0.99999f);
+
+    UpdateCharacter(throttled, 0.05f);
+    assert(std::abs(throttled.time - 0.2f) < 0.0001f); // Catches up with the skipped time
+    Pose later;
+    SampleAnimationClip(walk, 0.2f, later);
+    Quaternion interpolated = Nlerp(expected.boneTransforms[5].rotation, later.boneTransforms[5].rotation, 1.0f / 3.0f);
+    assert(Dot(throttled.pose.boneTransforms[5].rotation, interpolated) > 0.99999f);
+
+    UpdateCharacter(throttled, 0.05f);
+    UpdateCharacter(throttled, 0.05f);
+    assert(Dot(throttled.pose.boneTransforms[5].rotation, later.boneTransforms[5].rotation) > 0.99999f);
+    std::cout << "LOD update interval test passed!" << std::endl;
+
+    // LOD bone subset and IK switch: only the first two hierarchy levels are sampled and applied, deeper bones follow them
+    Skeleton lodSkeleton;
+    for (int bone = 0; bone < BoneCount; bone++)
+    {
+        lodSkeleton.AddBone("Bone" + std::to_string(bone), bone == 0 ? -1 : (bone - 1) / 3, Transform());
+    }
+
+    CharacterInstance reduced;
+    reduced.skeleton = &lodSkeleton;
+    reduced.blendTree = &walkTree;
+    reduced.useIK = true;
+    reduced.ikChain = { 0.3f, 0.25f };
+    reduced.lod.maxBoneDepth = 1;
+    reduced.lod.enableIK = false;
+    lodSkeleton.SetLocalTransform(4, Transform(Vector3(0.0f, 0.5f, 0.0f), Quaternion(), Vector3(1.0f, 1.0f, 1.0f)));
+    UpdateCharacter(reduced, 0.1f);
+
+    assert(reduced.lodBones.size() == 4);
+    assert(Dot(lodSkeleton.GetLocalPose(3).rotation, reduced.pose.boneTransforms[3].rotation) > 0.99999f);
+    assert(lodSkeleton.GetLocalPose(4).rotation.w == 1.0f); // Depth 2, left alone
+    assert(reduced.ikResult.isReachable == false);
+
+    // The dropped bone still follows its moving parent
+    Vector3 droppedBefore = lodSkeleton.GetWorldPose(4).position;
+    UpdateCharacter(reduced, 0.1f);
+    Transform droppedWorld = lodSkeleton.GetWorldPose(4);
+    Transform followed = Combine(lodSkeleton.GetWorldPose(1), lodSkeleton.GetLocalPose(4));
+    assert(Length(droppedWorld.position - droppedBefore) > 0.001f);
+    assert(Length(droppedWorld.position - followed.position) < 0.0001f);
+    assert(Dot(droppedWorld.rotation, followed.rotation) > 0.99999f);
+    std::cout << "LOD bone subset test passed!" << std::endl;
+
+    // Headless mode: only a hitbox bone and its ancestors are sampled, blended and propagated
+    Skeleton fullRig, serverRig;
+    for (int bone = 0; bone < BoneCount; bone++)
+    {
+        fullRig.AddBone("Bone" + std::to_string(bone), bone == 0 ? -1 : (bone - 1) / 3, Transform());
+        serverRig.AddBone("Bone" + std::to_string(bone), bone == 0 ? -1 : (bone - 1) / 3, Transform());
+    }
+
+    AnimationGraph locomotionGraph;
+    int locomotionSpeed = locomotionGraph.AddParameter("speed");
+    locomotionGraph.SetRoot(locomotionGraph.AddBlend1D(locomotionSpeed, { { 0.0f, locomotionGraph.AddClip(&idle) }, { 3.0f, locomotionGraph.AddClip(&walk) } }));
+
+    for (int useGraph = 0; useGraph < 2; useGraph++)
+    {
+        CharacterInstance client, server;
+        client.skeleton = &fullRig;
+        server.skeleton = &serverRig;
+        for (CharacterInstance* character : { &client, &server })
+        {
+            character->blendTree = &blendTree;
+            character->blendParameter = 1.5f;
+            if (useGraph)
+            {
+                character->graph = &locomotionGraph;
+                locomotionGraph.InitializeContext(character->graphContext);
+                character->graphContext.parameters[locomotionSpeed] = 1.5f;
+            }
+        }
+
+        int hitbox = 39;
+        SetRequiredBones(server, &hitbox, 1);
+        assert((server.requiredBones == std::vector<int>{ 0, 3, 12, 39 }));
+
+        serverRig.SetLocalTransform(5, Transform());
+        for (int frame = 0; frame < 3; frame++)
+        {
+            UpdateCharacter(client, 0.1f);
+            UpdateCharacter(server, 0.1f);
+        }
+
+        Transform clientHitbox = fullRig.GetWorldPose(hitbox);
+        Transform serverHitbox = serverRig.GetWorldPose(hitbox);
+        assert(Length(clientHitbox.position - serverHitbox.position) < 0.0001f);
+        assert(Dot(clientHitbox.rotation, serverHitbox.rotation) > 0.99999f);
+        assert(serverRig.GetLocalPose(5).rotation.w == 1.0f); // Not an ancestor of the hitbox, never written
+        assert(server.pose.boneTransforms[5].rotation.w == 1.0f); // Nor sampled
+    }
+    std::cout << "Headless required bones test passed!" << std::endl;
+
+    // LOD policy: distance bands, then a budget that coarsens the farthest characters first
+    AnimationLODPolicy policy;
+    AnimationLODLevel nearLevel, middleLevel, farLevel;
+    nearLevel.maxDistance = 10.0f;
+    nearLevel.costMicroseconds = 10.0f;
+    middleLevel.maxDistance = 30.0f;
+    middleLevel.updateInterval = 2;
+    middleLevel.costMicroseconds = 4.0f;
+    farLevel.updateInterval = 4;
+    farLevel.maxBoneDepth = 2;
+    farLevel.enableIK = false;
+    farLevel.costMicroseconds = 1.0f;
+    policy.AddLevel(nearLevel);
+    policy.AddLevel(middleLevel);
+    policy.AddLevel(farLevel);
+
+    std::vector<CharacterInstance> crowd(4);
+    float distances[4] = { 5.0f, 20.0f, 100.0f, 8.0f };
+    for (int i = 0; i < 4; i++)
+    {
+        crowd[i].lodDistance = distances[i];
+    }
+
+    policy.AssignByDistance(crowd.data(), 4);
+    assert(crowd[0].lodLevel == 0 && crowd[1].lodLevel == 1 && crowd[2].lodLevel == 2 && crowd[3].lodLevel == 0);
+    assert(crowd[2].lod.updateInterval == 4 && crowd[2].lod.enableIK == false);
+
+    // 20 us: the closest keeps full detail, the next two drop one level, the farthest gets the coarsest
+    for (int i = 0; i < 4; i++)
+    {
+        crowd[i].lodDistance = 1.0f + i;
+    }
+    policy.AssignByBudget(crowd.data(), 4, 20.0f);
+    assert(crowd[0].lodLevel == 0 && crowd[1].lodLevel == 1 && crowd[2].lodLevel == 1 && crowd[3].lodLevel == 2);
+
+    crowd[3].lastUpdateMicroseconds = 11.0f;
+    policy.RecordCosts(crowd.data(), 4);
+    assert(std::abs(policy.GetEstimatedCost(2) - 2.0f) < 0.0001f);
+    std::cout << "LOD policy test passed!" << std::endl;
+
+    // Root motion: a character walking a 3 m/s stride ends up where the clip's track says
+    std::vector<Pose> strideFrames = walkFrames;
+    for (int frame = 0; frame < 10; frame++)
+    {
+        strideFrames[frame].boneTransforms[0].position = Vector3(0, 0.1f, frame * 0.1f);
+    }
+    AnimationClip stride = CreateAnimationClip("Stride", 30.0f, strideFrames, 0.0001f, 0);
+
+    BlendTree1D strideTree;
+    strideTree.addAnimation(0.0f, &stride);
+
+    CharacterInstance walker;
+    walker.skeleton = &fadeSkeleton;
+    walker.blendTree = &strideTree;
+    for (int frame = 0; frame < 10; frame++)
+    {
+        UpdateCharacter(walker, 0.05f);
+    }
+    RootMotion travelled = GetRootMotion(stride, 0.0f, walker.time);
+    assert(Length(walker.rootMotionAccumulator.position - travelled.translation) < 0.001f);
+    assert(std::abs(walker.rootMotionAccumulator.position.z - 1.5f) < 0.001f);
+
+    // Graph: halfway between idle (no track) and the stride, half of the stride's motion
+    AnimationGraph strideGraph;
+    int strideSpeed = strideGraph.AddParameter("speed");
+    strideGraph.SetRoot(strideGraph.AddBlend1D(strideSpeed, { { 0.0f, strideGraph.AddClip(&idle) }, { 3.0f, strideGraph.AddClip(&stride) } }));
+
+    CharacterInstance graphWalker;
+    graphWalker.skeleton = &fadeSkeleton;
+    graphWalker.graph = &strideGraph;
+    strideGraph.InitializeContext(graphWalker.graphContext);
+    graphWalker.graphContext.parameters[strideSpeed] = 1.5f;
+    UpdateCharacter(graphWalker, 0.1f);
+    assert(std::abs(graphWalker.rootMotion.translation.z - 0.5f * GetRootMotion(stride, 0.0f, 0.1f).translation.z) < 0.0001f);
+    std::cout << "Root motion accumulation test passed!" << std::endl;
+
+    std::cout << "All Parallel Animation Update tests passed!" << std::endl;
+}
+
+void TestAnimationProfiler()
+{
+    std::cout << "\n=== ANIMATION PROFILER TESTS ===" << std::endl;
+
+    // Scopes and counters recorded directly, on the calling thread and on workers
+    ResetProfile();
+    SetProfileSampleInterval(1);
+    JobSystem jobs(2);
+    jobs.ParallelFor(8, 1, [](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            ProfileScope update(ProfileUpdate);
+            {
+                ProfileScope blending(ProfileBlending);
+            }
+            AddProfileCount(CounterPosesBlended, 2);
+        }
+    });
+
+    ProfileSnapshot snapshot;
+    TakeProfileSnapshot(snapshot);
+    ProfileStageStats update = snapshot.GetStage(ProfileUpdate);
+    ProfileStageStats blending = snapshot.GetStage(ProfileBlending);
+    assert(update.calls == 8 && blending.calls == 8);
+    assert(update.totalNanoseconds >= blending.totalNanoseconds);
+    assert(snapshot.GetCounter(CounterPosesBlended) == 16);
+    assert(!snapshot.threads.empty());
+
+    uint64_t histogramCalls = 0;
+    for (uint64_t bucket : update.histogram)
+    {
+        histogramCalls += bucket;
+    }
+    assert(histogramCalls == update.calls);
+    std::cout << "Scoped timing test passed!" << std::endl;
+
+    // One outermost scope in 4 is timed together with its nested scopes; counters always count
+    ResetProfile();
+    SetProfileSampleInterval(4);
+    for (int i = 0; i < 8; i++)
+    {
+        ProfileScope sampledUpdate(ProfileUpdate);
+        {
+            ProfileScope sampledIK(ProfileIK);
+        }
+        AddProfileCount(CounterCharacters, 1);
+    }
+    TakeProfileSnapshot(snapshot);
+    assert(snapshot.GetStage(ProfileUpdate).calls == 2 && snapshot.GetStage(ProfileIK).calls == 2);
+    assert(snapshot.GetCounter(CounterCharacters) == 8);
+
+    std::ostringstream json;
+    ExportProfileJson(snapshot, json);
+    assert(json.str().find("\"sampleInterval\": 4") != std::string::npos);
+    assert(json.str().find("\"ik\": { \"calls\": 2") != std::string::npos);
+    std::cout << "Sampling and export test passed!" << std::endl;
+
+#if defined(ANIMATION_PROFILING)
+    // The update pipeline reports its stages and counters
+    Skeleton skeleton;
+    skeleton.AddBone("Root", -1, Transform());
+    skeleton.AddBone("Spine", 0, Transform());
+    skeleton.AddBone("Head", 1, Transform());
+
+    std::vector<Pose> frames(4, Pose(3, Transform()));
+    AnimationClip idle = CreateAnimationClip("Idle", 30.0f, frames);
+    AnimationClip walk = CreateAnimationClip("Walk", 30.0f, frames);
+    BlendTree1D blendTree;
+    blendTree.addAnimation(0.0f, &idle);
+    blendTree.addAnimation(1.0f, &walk);
+
+    CharacterInstance character;
+    character.skeleton = &skeleton;
+    character.blendTree = &blendTree;
+    character.blendParameter = 0.5f;
+    character.useIK = true;
+    character.ikChain = { 0.3f, 0.25f };
+    character.ikTarget = Vector3(5.0f, 0.0f, 0.0f);
+
+    ResetProfile();
+    SetProfileSampleInterval(1);
+    UpdateCharacter(character, 0.1f);
+    TakeProfileSnapshot(snapshot);
+
+    assert(snapshot.GetCounter(CounterCharacters) == 1);
+    assert(snapshot.GetCounter(CounterClipsSampled) == 2);
+    assert(snapshot.GetCounter(CounterPosesBlended) == 2);
+    assert(snapshot.GetCounter(CounterBonesProcessed) == 3);
+    assert(snapshot.GetCounter(CounterIKSolves) == 1 && snapshot.GetCounter(CounterIKIterations) == 0);
+    assert(snapshot.GetCounter(CounterIKUnreachable) == 1);
+    assert(snapshot.GetStage(ProfileUpdate).calls == 1 && snapshot.GetStage(ProfileHierarchy).calls == 1);
+    assert(snapshot.GetStage(ProfileUpdate).totalNanoseconds >= snapshot.GetStage(ProfileHierarchy).totalNanoseconds);
+    std::cout << "Pipeline instrumentation test passed!" << std::endl;
+#endif
+
+    SetProfileSampleInterval(32);
+    std::cout << "All Animation Profiler tests passed!" << std::endl;
+}
+
+void TestFrameArena()
+{
+    std::cout << "\n=== FRAME ARENA TESTS ===" << std::endl;
+
+    // Bump allocation, rewinding to a marker, and growth past the first block
+    FrameArena arena(1024);
+    float* first = arena.Allocate<float>(3);
+    assert(((uintptr_t)first & 15) == 0);
+    assert(arena.GetUsedBytes() == 12);
+
+    {
+        FrameArenaScope scope(arena);
+        Transform* transforms = arena.Allocate<Transform>(100);
+        assert((unsigned char*)transforms >= (unsigned char*)(first + 3));
+        assert(arena.GetUsedBytes() > 1024 && arena.GetCapacity() > 1024);
+    }
+    assert(arena.GetUsedBytes() == 12);
+    assert(arena.GetBlockAllocationCount() == 2);
+    size_t peak = arena.GetPeakBytes();
+    assert(peak > 1024);
+    std::cout << "Allocation and rewind test passed!" << std::endl;
+
+    // Reset leaves one block holding the whole frame, so the same frame no longer grows the arena
+    arena.Reset();
+    assert(arena.GetUsedBytes() == 0 && arena.GetCapacity() >= peak);
+    int blocks = arena.GetBlockAllocationCount();
+    arena.Allocate<float>(3);
+    arena.Allocate<Transform>(100);
+    arena.Reset();
+    assert(arena.GetBlockAllocationCount() == blocks);
+    assert(arena.GetPeakBytes() == peak);
+    std::cout << "Reset test passed!" << std::endl;
+
+    // Raw sampling and blending match the Pose overloads
+    Skeleton skeleton;
+    skeleton.AddBone("Root", -1, Transform());
+    skeleton.AddBone("Spine", 0, Transform());
+    skeleton.AddBone("Head", 1, Transform());
+
+    std::vector<Pose> idleFrames(4, Pose(3, Transform()));
+    std::vector<Pose> walkFrames(4, Pose(3, Transform()));
+    for (int f = 0; f < 4; f++)
+    {
+        walkFrames[f].boneTransforms[1].position = Vector3(0.0f, 1.0f + 0.1f * f, 0.0f);
+        walkFrames[f].boneTransforms[2].rotation = Quaternion::FromAxisAngle(Vector3(0.0f, 0.0f, 1.0f), 0.2f * f);
+    }
+    AnimationClip idle = CreateAnimationClip("Idle", 30.0f, idleFrames);
+    AnimationClip walk = CreateAnimationClip("Walk", 30.0f, walkFrames);
+
+    Pose idlePose;
+    Pose walkPose;
+    SampleAnimationClip(idle, 0.05f, idlePose);
+    SampleAnimationClip(walk, 0.05f, walkPose);
+
+    Transform* rawWalk = arena.Allocate<Transform>(3);
+    SampleAnimationClip(walk, 0.05f, nullptr, 0, rawWalk);
+    for (int i = 0; i < 3; i++)
+    {
+        assert(std::abs(rawWalk[i].position.y - walkPose.boneTransforms[i].position.y) < 0.0001f);
+        assert(Dot(rawWalk[i].rotation, walkPose.boneTransforms[i].rotation) > 0.99999f);
+    }
+
+    const Pose* poses[2] = { &idlePose, &walkPose };
+    const Transform* rawPoses[2] = { idlePose.boneTransforms.data(), walkPose.boneTransforms.data() };
+    float weights[2] = { 0.25f, 0.75f };
+    Pose blended;
+    BlendPoses(poses, weights, 2, blended);
+    Transform* rawBlended = arena.Allocate<Transform>(3);
+    BlendPoses(rawPoses, weights, 2, 3, nullptr, 0, rawBlended);
+    for (int i = 0; i < 3; i++)
+    {
+        assert(std::abs(rawBlended[i].position.y - blended.boneTransforms[i].position.y) < 0.0001f);
+        assert(Dot(rawBlended[i].rotation, blended.boneTransforms[i].rotation) > 0.99999f);
+    }
+    std::cout << "Raw sampling and blending test passed!" << std::endl;
+
+    // The update pipeline takes its transient buffers from the thread arenas and gives them back per character
+    BlendTree1D blendTree;
+    blendTree.addAnimation(0.0f, &idle);
+    blendTree.addAnimation(1.0f, &walk);
+
+    const int CharacterCount = 16;
+    std::vector<Skeleton> skeletons(CharacterCount, skeleton);
+    std::vector<CharacterInstance> characters(CharacterCount);
+    for (int i = 0; i < CharacterCount; i++)
+    {
+        characters[i].skeleton = &skeletons[i];
+        characters[i].blendTree = &blendTree;
+        characters[i].blendParameter = 0.75f;
+    }
+
+    FrameArena& threadArena = GetThreadFrameArena();
+    size_t usedBefore = threadArena.GetUsedBytes();
+    UpdateCharacter(characters[0], 0.05f);
+    assert(threadArena.GetUsedBytes() == usedBefore);
+    assert(threadArena.GetPeakBytes() >= usedBefore + 2 * 3 * sizeof(Transform));
+    for (int i = 0; i < 3; i++)
+    {
+        assert(std::abs(characters[0].pose.boneTransforms[i].position.y - blended.boneTransforms[i].position.y) < 0.0001f);
+    }
+
+    // Once warm, a thread's frames reuse its arena without growing it
+    for (int frame = 0; frame < 2; frame++)
+    {
+        BeginArenaFrame();
+        for (CharacterInstance& character : characters)
+        {
+            UpdateCharacter(character, 1.0f / 60.0f);
+        }
+    }
+    int warmBlocks = threadArena.GetBlockAllocationCount();
+    for (int frame = 0; frame < 2; frame++)
+    {
+        BeginArenaFrame();
+        for (CharacterInstance& character : characters)
+        {
+            UpdateCharacter(character, 1.0f / 60.0f);
+        }
+    }
+    assert(threadArena.GetBlockAllocationCount() == warmBlocks);
+
+    // Which workers pick up characters varies, so only the totals' relations are checked
+    JobSystem jobs(2);
+    AnimationUpdateSettings settings;
+    UpdateCharacters(jobs, characters.data(), CharacterCount, 1.0f / 60.0f, settings);
+    UpdateCharacters(jobs, characters.data(), CharacterCount, 1.0f / 60.0f, settings);
+    FrameArenaStatistics statistics = GetFrameArenaStatistics();
+
+    assert(statistics.arenaCount >= 1);
+    assert(statistics.peakBytes >= statistics.maxArenaPeakBytes && statistics.maxArenaPeakBytes > 0);
+    assert(statistics.capacity >= statistics.peakBytes);
+    std::cout << "Pipeline arena test passed!" << std::endl;
+
+    std::cout << "All Frame Arena tests passed!" << std::endl;
+}
 #pragma endregion
 
 int main(int argc, char *argv[])
@@ -347,9 +2096,19 @@ int main(int argc, char *argv[])
 
     TestStateMachine();
     TestBlendTree1D();
+    TestBlendSpace2D();
     TestSkeleton();
+    TestSkeletonPoses();
+    TestSkeletonInstancePool();
     TestAnimationBlending();
+    TestAnimationClip();
+    TestAnimationFile();
+    TestAnimationGraph();
     TestIKSolver();
+    TestSkinning();
+    TestParallelUpdate();
+    TestAnimationProfiler();
+    TestFrameArena();
 
     std::cout << "\n=====================================" << std::endl;
     std::cout << "  ALL TESTS PASSED SUCCESSFULLY" << std::endl;